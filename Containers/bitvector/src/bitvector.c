@@ -0,0 +1,585 @@
+/*
+MIT License
+
+Copyright (c) 2018 Joseph Ojeda
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <stdlib.h> // malloc, realloc, free
+#include <string.h> // memcpy, memset
+
+#include "./bitvector.h"
+
+#define _WORD_BITS_ 64
+#define _RANK_WORDS_ 8  // Words per rank directory entry, 512 bits.
+
+/*
+ * Bits past size in the last word are always zero, so whole-word counts and
+ * searches never see them. ranks[i] counts the set bits before word
+ * i * _RANK_WORDS_; it is rebuilt on demand after any mutation.
+ */
+struct _internal_bitvector {
+    uint64_t* words;
+    size_t size;
+    size_t words_capacity;
+    size_t* ranks;
+    bool ranks_valid;
+};
+/*
+ * Check if a bitvector and it's bits are not null.
+ */
+static bool bitvector_status(bitvector_t* const self) {
+    return self && self->words;
+}
+
+static size_t words_for(const size_t bits_count) {
+    return (bits_count + _WORD_BITS_ - 1) / _WORD_BITS_;
+}
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && !defined(__POPCNT__)
+#define _POPCNT_DISPATCH_ 1
+#endif
+
+static size_t bit_count(const uint64_t word) {
+#if defined(__GNUC__) && (defined(__POPCNT__) || !(defined(__x86_64__) || defined(__i386__)))
+    return (size_t)__builtin_popcountll(word);
+#else
+    // Without -mpopcnt the builtin is a libgcc call, slower than this.
+    uint64_t x = word - ((word >> 1) & 0x5555555555555555ull);
+    x = (x & 0x3333333333333333ull) + ((x >> 2) & 0x3333333333333333ull);
+    x = (x + (x >> 4)) & 0x0f0f0f0f0f0f0f0full;
+    return (size_t)((x * 0x0101010101010101ull) >> 56);
+#endif
+}
+
+#if defined(_POPCNT_DISPATCH_)
+__attribute__((target("popcnt")))
+static size_t count_words_popcnt(const uint64_t* const words, const size_t count) {
+    size_t total = 0;
+    for (size_t i = 0; i < count; ++i) {
+        total += (size_t)__builtin_popcountll(words[i]);
+    }
+    return total;
+}
+#endif
+/*
+ * Set bits in count words. Builds that do not target popcnt still use the
+ * instruction when the CPU has it, checked at run time.
+ */
+static size_t count_words(const uint64_t* const words, const size_t count) {
+#if defined(_POPCNT_DISPATCH_)
+    if (__builtin_cpu_supports("popcnt")) {
+        return count_words_popcnt(words, count);
+    }
+#endif
+    size_t total = 0;
+    for (size_t i = 0; i < count; ++i) {
+        total += bit_count(words[i]);
+    }
+    return total;
+}
+/*
+ * Index of the lowest set bit of a non-zero word. On x86 the builtin is
+ * rep bsf, which runs as tzcnt on CPUs that have it, so no dispatch is needed.
+ */
+static size_t bit_scan(const uint64_t word) {
+#if defined(__GNUC__)
+    return (size_t)__builtin_ctzll(word);
+#else
+    size_t index = 0;
+    while (!(word >> index & 1)) {
+        ++index;
+    }
+    return index;
+#endif
+}
+/*
+ * Position of the rank-th (0-based) set bit of a word holding more than rank set bits.
+ */
+static size_t bit_select(uint64_t word, size_t rank) {
+    while (rank--) {
+        word &= word - 1;
+    }
+    return bit_scan(word);
+}
+/*
+ * Zero the bits past size in the last word, restoring the padding invariant.
+ */
+static void bitvector_trim(bitvector_t* const self) {
+    if (self->size % _WORD_BITS_) {
+        self->words[self->size / _WORD_BITS_] &= ((uint64_t)1 << (self->size % _WORD_BITS_)) - 1;
+    }
+}
+
+static bool bitvector_build_ranks(bitvector_t* const self) {
+    if (self->ranks_valid) {
+        return true;
+    }
+    const size_t words = words_for(self->size);
+    const size_t entries = words / _RANK_WORDS_ + 1;
+    size_t* ranks = realloc(self->ranks, entries * sizeof(size_t));
+    if (!ranks) {
+        return false;
+    }
+    size_t total = 0;
+    for (size_t i = 0; i < words; i += _RANK_WORDS_) {
+        ranks[i / _RANK_WORDS_] = total;
+        total += count_words(self->words + i, words - i < _RANK_WORDS_ ? words - i : _RANK_WORDS_);
+    }
+    if (!(words % _RANK_WORDS_)) {
+        ranks[entries - 1] = total;
+    }
+    self->ranks = ranks;
+    self->ranks_valid = true;
+    return true;
+}
+///////////
+// Basic //
+///////////
+/**
+ * @brief Initialize a new bitvector container with every bit cleared.
+ *
+ * @param bits_count How many bits the bitvector holds.
+ *
+ * @return A new bitvector container.
+ */
+bitvector_t* bitvector_init(const size_t bits_count) {
+    bitvector_t* init = malloc(sizeof(bitvector_t));
+    if (!init) {
+        return NULL;
+    }
+    init->words_capacity = words_for(bits_count) ? words_for(bits_count) : 1;
+    init->words = calloc(init->words_capacity, sizeof(uint64_t));
+    if (!init->words) {
+        free(init);
+        return NULL;
+    }
+    init->size = bits_count;
+    init->ranks = NULL;
+    init->ranks_valid = false;
+    return init;
+}
+/**
+ * @brief Free the bits of a bitvector container plus the container itself.
+ *
+ * @param self The bitvector container to be freed.
+ */
+void bitvector_destroy(bitvector_t* const self) {
+    if (!self) {
+        return;
+    }
+    free(self->words);
+    free(self->ranks);
+    free(self);
+}
+////////////
+// Access //
+////////////
+/**
+ * @brief Return the words holding the bits of a bitvector container.
+ *
+ * Bit i is bit (i % 64) of word (i / 64), bits past size are zero.
+ *
+ * @param self Bitvector container to get words from.
+ *
+ * @return Return bitvector_words(self) words.
+ */
+const uint64_t* bitvector_data(bitvector_t* const self) {
+    if (!bitvector_status(self)) {
+        return NULL;
+    }
+    return self->words;
+}
+/**
+ * @brief Check a bit of a bitvector container.
+ *
+ * @param self  Bitvector container to get bit from.
+ * @param index Position of the bit. Start point is 0.
+ *
+ * @return Return true if the bit is set, false if it is cleared or out of range.
+ */
+bool bitvector_test(bitvector_t* const self, const size_t index) {
+    if (!bitvector_status(self) || index >= self->size) {
+        return false;
+    }
+    return self->words[index / _WORD_BITS_] >> (index % _WORD_BITS_) & 1;
+}
+//////////////
+// Capacity //
+//////////////
+/**
+ * @brief Returns if a bitvector container holds no bits.
+ *
+ * @param self Bitvector container to check size from.
+ *
+ * @return Return true if self size is 0.
+ */
+bool bitvector_is_empty(bitvector_t* const self) {
+    return bitvector_size(self) == 0;
+}
+/**
+ * @brief Change how many bits a bitvector container holds. Added bits are cleared.
+ *
+ * @param self          Bitvector container that will be changed.
+ * @param bits_count    New size in bits.
+ */
+void bitvector_resize(bitvector_t* const self, const size_t bits_count) {
+    if (!bitvector_status(self)) {
+        return;
+    }
+    const size_t words = words_for(bits_count);
+    if (words > self->words_capacity) {
+        size_t capacity = self->words_capacity * 2 > words ? self->words_capacity * 2 : words;
+        uint64_t* temp = realloc(self->words, capacity * sizeof(uint64_t));
+        if (!temp) {
+            return;
+        }
+        self->words = temp;
+        self->words_capacity = capacity;
+    }
+    const size_t used = words_for(self->size);
+    if (words > used) {
+        memset(self->words + used, 0, (words - used) * sizeof(uint64_t));
+    }
+    if (bits_count < self->size) {
+        // Clear the dropped bits so growing back yields zeros.
+        self->size = bits_count;
+        bitvector_trim(self);
+        memset(self->words + words, 0, (used - words) * sizeof(uint64_t));
+    }
+    self->size = bits_count;
+    self->ranks_valid = false;
+}
+/**
+ * @brief Returns how many bits a bitvector container holds.
+ *
+ * @param self Bitvector container to retrieve size from.
+ *
+ * @return Return the size of self in bits.
+ */
+size_t bitvector_size(bitvector_t* const self) {
+    if (!bitvector_status(self)) {
+        return 0;
+    }
+    return self->size;
+}
+/**
+ * @brief Returns how many 64-bit words hold the bits of a bitvector container.
+ *
+ * @param self Bitvector container to retrieve words count from.
+ *
+ * @return Return the words count of self.
+ */
+size_t bitvector_words(bitvector_t* const self) {
+    if (!bitvector_status(self)) {
+        return 0;
+    }
+    return words_for(self->size);
+}
+/////////////////
+// Operations //
+////////////////
+/**
+ * @brief Intersect a bitvector container with another one, word by word.
+ *
+ * Bits of dst past the size of src are cleared.
+ *
+ * @param dst Bitvector container that will hold dst AND src.
+ * @param src Bitvector container combined into dst.
+ */
+void bitvector_and(bitvector_t* const dst, bitvector_t* const src) {
+    if (!bitvector_status(dst) || !bitvector_status(src)) {
+        return;
+    }
+    const size_t dst_words = words_for(dst->size);
+    const size_t src_words = words_for(src->size);
+    const size_t common = dst_words < src_words ? dst_words : src_words;
+    for (size_t i = 0; i < common; ++i) {
+        dst->words[i] &= src->words[i];
+    }
+    if (dst_words > common) {
+        memset(dst->words + common, 0, (dst_words - common) * sizeof(uint64_t));
+    }
+    dst->ranks_valid = false;
+}
+/**
+ * @brief Remove every bit from a bitvector container.
+ *
+ * @param self Bitvector container whose bits are going to be removed.
+ */
+void bitvector_clear(bitvector_t* const self) {
+    bitvector_resize(self, 0);
+}
+/**
+ * @brief Copy the bits from a bitvector container to another one.
+ *
+ * @param dst Bitvector container that will recieve the copied bits.
+ * @param src Bitvector container whose bits will be copied.
+ *
+ * @return Return dst containing a copy of all bits in src.
+ */
+bitvector_t* bitvector_copy(bitvector_t* dst, bitvector_t* const src) {
+    if (!bitvector_status(src)) {
+        return NULL;
+    }
+    if (!dst) {
+        dst = bitvector_init(src->size);
+    }
+    else {
+        bitvector_resize(dst, src->size);
+    }
+    if (!bitvector_status(dst) || dst->size != src->size) {
+        return dst;
+    }
+    memcpy(dst->words, src->words, words_for(src->size) * sizeof(uint64_t));
+    dst->ranks_valid = false;
+    return dst;
+}
+/**
+ * @brief Count the set bits of a bitvector container.
+ *
+ * @param self Bitvector container whose bits will be counted.
+ *
+ * @return Return how many bits are set.
+ */
+size_t bitvector_count(bitvector_t* const self) {
+    if (!bitvector_status(self)) {
+        return 0;
+    }
+    return count_words(self->words, words_for(self->size));
+}
+/**
+ * @brief Set or clear every bit of a bitvector container.
+ *
+ * @param self  Bitvector container that will be filled.
+ * @param value Value given to every bit.
+ */
+void bitvector_fill(bitvector_t* const self, const bool value) {
+    if (!bitvector_status(self)) {
+        return;
+    }
+    memset(self->words, value ? 0xff : 0, words_for(self->size) * sizeof(uint64_t));
+    bitvector_trim(self);
+    self->ranks_valid = false;
+}
+/**
+ * @brief Find the first set bit of a bitvector container.
+ *
+ * @param self Bitvector container to search.
+ *
+ * @return Return the index of the first set bit, or SIZE_MAX if none is set.
+ */
+size_t bitvector_find_first(bitvector_t* const self) {
+    return bitvector_find_next(self, 0);
+}
+/**
+ * @brief Find the first set bit of a bitvector container at or after a position.
+ *
+ * @param self  Bitvector container to search.
+ * @param index Position the search starts at.
+ *
+ * @return Return the index of the first set bit at or after index, or SIZE_MAX if none is set.
+ */
+size_t bitvector_find_next(bitvector_t* const self, const size_t index) {
+    if (!bitvector_status(self) || index >= self->size) {
+        return SIZE_MAX;
+    }
+    const size_t words = words_for(self->size);
+    size_t word = index / _WORD_BITS_;
+    uint64_t bits = self->words[word] & (~(uint64_t)0 << (index % _WORD_BITS_));
+    while (!bits) {
+        if (++word == words) {
+            return SIZE_MAX;
+        }
+        bits = self->words[word];
+    }
+    return word * _WORD_BITS_ + bit_scan(bits);
+}
+/**
+ * @brief Toggle a bit of a bitvector container.
+ *
+ * @param self  Bitvector container whose bit will be toggled.
+ * @param index Position of the bit. Start point is 0.
+ */
+void bitvector_flip(bitvector_t* const self, const size_t index) {
+    if (!bitvector_status(self) || index >= self->size) {
+        return;
+    }
+    self->words[index / _WORD_BITS_] ^= (uint64_t)1 << (index % _WORD_BITS_);
+    self->ranks_valid = false;
+}
+/**
+ * @brief Toggle every bit of a bitvector container, word by word.
+ *
+ * @param self Bitvector container that will be complemented.
+ */
+void bitvector_not(bitvector_t* const self) {
+    if (!bitvector_status(self)) {
+        return;
+    }
+    const size_t words = words_for(self->size);
+    for (size_t i = 0; i < words; ++i) {
+        self->words[i] = ~self->words[i];
+    }
+    bitvector_trim(self);
+    self->ranks_valid = false;
+}
+/**
+ * @brief Unite a bitvector container with another one, word by word.
+ *
+ * Bits of src past the size of dst are ignored.
+ *
+ * @param dst Bitvector container that will hold dst OR src.
+ * @param src Bitvector container combined into dst.
+ */
+void bitvector_or(bitvector_t* const dst, bitvector_t* const src) {
+    if (!bitvector_status(dst) || !bitvector_status(src)) {
+        return;
+    }
+    const size_t dst_words = words_for(dst->size);
+    const size_t src_words = words_for(src->size);
+    const size_t common = dst_words < src_words ? dst_words : src_words;
+    for (size_t i = 0; i < common; ++i) {
+        dst->words[i] |= src->words[i];
+    }
+    bitvector_trim(dst);
+    dst->ranks_valid = false;
+}
+/**
+ * @brief Count the set bits of a bitvector container before a position.
+ *
+ * Backed by a directory of counts per 512 bits, rebuilt on the first call after a mutation.
+ *
+ * @param self  Bitvector container whose bits will be counted.
+ * @param index Position the count stops at, exclusive. Clamped to size.
+ *
+ * @return Return how many bits in [0, index) are set.
+ */
+size_t bitvector_rank(bitvector_t* const self, const size_t index) {
+    if (!bitvector_status(self) || !bitvector_build_ranks(self)) {
+        return 0;
+    }
+    const size_t end = index < self->size ? index : self->size;
+    const size_t word = end / _WORD_BITS_;
+    size_t total = self->ranks[word / _RANK_WORDS_] + count_words(self->words + word - word % _RANK_WORDS_, word % _RANK_WORDS_);
+    if (end % _WORD_BITS_) {
+        const uint64_t head = self->words[word] & (((uint64_t)1 << (end % _WORD_BITS_)) - 1);
+        total += count_words(&head, 1);
+    }
+    return total;
+}
+/**
+ * @brief Clear a bit of a bitvector container.
+ *
+ * @param self  Bitvector container whose bit will be cleared.
+ * @param index Position of the bit. Start point is 0.
+ */
+void bitvector_reset(bitvector_t* const self, const size_t index) {
+    if (!bitvector_status(self) || index >= self->size) {
+        return;
+    }
+    self->words[index / _WORD_BITS_] &= ~((uint64_t)1 << (index % _WORD_BITS_));
+    self->ranks_valid = false;
+}
+/**
+ * @brief Find a set bit of a bitvector container by its rank.
+ *
+ * Inverse of bitvector_rank: bitvector_rank(self, bitvector_select(self, r)) == r.
+ *
+ * @param self Bitvector container to search.
+ * @param rank How many set bits precede the wanted one. Start point is 0.
+ *
+ * @return Return the index of the set bit, or SIZE_MAX if fewer than rank + 1 bits are set.
+ */
+size_t bitvector_select(bitvector_t* const self, const size_t rank) {
+    if (!bitvector_status(self) || !bitvector_build_ranks(self)) {
+        return SIZE_MAX;
+    }
+    const size_t words = words_for(self->size);
+    // Last directory entry whose count does not exceed rank.
+    size_t low = 0;
+    size_t high = words / _RANK_WORDS_ + 1;
+    while (high - low > 1) {
+        const size_t middle = low + (high - low) / 2;
+        if (self->ranks[middle] <= rank) {
+            low = middle;
+        }
+        else {
+            high = middle;
+        }
+    }
+    size_t remaining = rank - self->ranks[low];
+    for (size_t i = low * _RANK_WORDS_; i < words; ++i) {
+        const size_t count = count_words(&self->words[i], 1);
+        if (remaining < count) {
+            return i * _WORD_BITS_ + bit_select(self->words[i], remaining);
+        }
+        remaining -= count;
+    }
+    return SIZE_MAX;
+}
+/**
+ * @brief Set a bit of a bitvector container.
+ *
+ * @param self  Bitvector container whose bit will be set.
+ * @param index Position of the bit. Start point is 0.
+ */
+void bitvector_set(bitvector_t* const self, const size_t index) {
+    if (!bitvector_status(self) || index >= self->size) {
+        return;
+    }
+    self->words[index / _WORD_BITS_] |= (uint64_t)1 << (index % _WORD_BITS_);
+    self->ranks_valid = false;
+}
+/**
+ * @brief Swap the content of two bitvector containers.
+ *
+ * @param dst Bitvector container that will hold the swapped content.
+ * @param src Bitvector container whose content will be swapped.
+ */
+void bitvector_swap(bitvector_t* const dst, bitvector_t* const src) {
+    if (!bitvector_status(dst) || !bitvector_status(src)) {
+        return;
+    }
+    bitvector_t temp = *dst;
+    *dst = *src;
+    *src = temp;
+}
+/**
+ * @brief Combine a bitvector container with another one by exclusive or, word by word.
+ *
+ * Bits of src past the size of dst are ignored.
+ *
+ * @param dst Bitvector container that will hold dst XOR src.
+ * @param src Bitvector container combined into dst.
+ */
+void bitvector_xor(bitvector_t* const dst, bitvector_t* const src) {
+    if (!bitvector_status(dst) || !bitvector_status(src)) {
+        return;
+    }
+    const size_t dst_words = words_for(dst->size);
+    const size_t src_words = words_for(src->size);
+    const size_t common = dst_words < src_words ? dst_words : src_words;
+    for (size_t i = 0; i < common; ++i) {
+        dst->words[i] ^= src->words[i];
+    }
+    bitvector_trim(dst);
+    dst->ranks_valid = false;
+}
@@ -0,0 +1,73 @@
+/*
+MIT License
+
+Copyright (c) 2018 Joseph Ojeda
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef BITVECTOR_H
+#define BITVECTOR_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+ * Bits packed 64 per word. Bulk operations work a word at a time, counting
+ * and searching use the popcount and trailing-zero-count builtins.
+ */
+typedef struct _internal_bitvector bitvector_t;
+///////////
+// Basic //
+///////////
+bitvector_t*    bitvector_init(const size_t bits_count);
+void            bitvector_destroy(bitvector_t* const self);
+////////////
+// Access //
+////////////
+const uint64_t* bitvector_data(bitvector_t* const self);
+bool            bitvector_test(bitvector_t* const self, const size_t index);
+//////////////
+// Capacity //
+//////////////
+bool            bitvector_is_empty(bitvector_t* const self);
+void            bitvector_resize(bitvector_t* const self, const size_t bits_count);
+size_t          bitvector_size(bitvector_t* const self);
+size_t          bitvector_words(bitvector_t* const self);
+/////////////////
+// Operations //
+////////////////
+void            bitvector_and(bitvector_t* const dst, bitvector_t* const src);
+void            bitvector_clear(bitvector_t* const self);
+bitvector_t*    bitvector_copy(bitvector_t* dst, bitvector_t* const src);
+size_t          bitvector_count(bitvector_t* const self);
+void            bitvector_fill(bitvector_t* const self, const bool value);
+size_t          bitvector_find_first(bitvector_t* const self);
+size_t          bitvector_find_next(bitvector_t* const self, const size_t index);
+void            bitvector_flip(bitvector_t* const self, const size_t index);
+void            bitvector_not(bitvector_t* const self);
+void            bitvector_or(bitvector_t* const dst, bitvector_t* const src);
+size_t          bitvector_rank(bitvector_t* const self, const size_t index);
+void            bitvector_reset(bitvector_t* const self, const size_t index);
+size_t          bitvector_select(bitvector_t* const self, const size_t rank);
+void            bitvector_set(bitvector_t* const self, const size_t index);
+void            bitvector_swap(bitvector_t* const dst, bitvector_t* const src);
+void            bitvector_xor(bitvector_t* const dst, bitvector_t* const src);
+
+#endif
@@ -0,0 +1,70 @@
+/*
+MIT License
+
+Copyright (c) 2018 Joseph Ojeda
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "./src/bitvector.h"
+
+int main(void) {
+    bitvector_t* bitvector1 = bitvector_init(1000);
+    for (size_t i = 0; i < 1000; i += 3) {
+        bitvector_set(bitvector1, i);
+    }
+    printf("bitvector1.size = %ld\n", bitvector_size(bitvector1));
+    printf("bitvector1.words = %ld\n", bitvector_words(bitvector1));
+    printf("bitvector1.count = %ld\n", bitvector_count(bitvector1));
+    printf("bitvector1.test(300) = %d\n", bitvector_test(bitvector1, 300));
+    printf("bitvector1.test(301) = %d\n", bitvector_test(bitvector1, 301));
+    printf("bitvector1.find_next(301) = %ld\n", bitvector_find_next(bitvector1, 301));
+    printf("bitvector1.rank(300) = %ld\n", bitvector_rank(bitvector1, 300));
+    printf("bitvector1.select(100) = %ld\n", bitvector_select(bitvector1, 100));
+
+    bitvector_t* bitvector2 = bitvector_init(1000);
+    for (size_t i = 0; i < 1000; i += 2) {
+        bitvector_set(bitvector2, i);
+    }
+    bitvector_t* bitvector3 = bitvector_copy(NULL, bitvector1);
+    bitvector_and(bitvector3, bitvector2);
+    printf("\n(bitvector1 & bitvector2).count = %ld\n", bitvector_count(bitvector3));
+    bitvector_copy(bitvector3, bitvector1);
+    bitvector_or(bitvector3, bitvector2);
+    printf("(bitvector1 | bitvector2).count = %ld\n", bitvector_count(bitvector3));
+    bitvector_xor(bitvector3, bitvector2);
+    printf("(bitvector1 | bitvector2) ^ bitvector2 .count = %ld\n", bitvector_count(bitvector3));
+    bitvector_not(bitvector3);
+    printf("~bitvector3.count = %ld\n", bitvector_count(bitvector3));
+
+    bitvector_reset(bitvector1, 0);
+    bitvector_resize(bitvector1, 2000);
+    printf("\nbitvector1.size = %ld\n", bitvector_size(bitvector1));
+    printf("bitvector1.count = %ld\n", bitvector_count(bitvector1));
+    printf("bitvector1.find_first = %ld\n", bitvector_find_first(bitvector1));
+
+    bitvector_destroy(bitvector1);
+    bitvector_destroy(bitvector2);
+    bitvector_destroy(bitvector3);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,413 @@
+/*
+MIT License
+
+Copyright (c) 2018 Joseph Ojeda
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <stdlib.h> // malloc, calloc, free
+#include <string.h> // memcpy, memmove
+
+#include "./deque.h"
+
+#define _BLOCK_BYTES_ 4096
+#define _MIN_BLOCK_ELEMENTS_ 16
+#define _MIN_MAP_BLOCKS_ 8
+
+/*
+ * Elements live in fixed-size blocks that never move. The map holds one
+ * pointer per block; only the used block range is allocated. Element i is
+ * at global position start + i, block (position >> block_shift).
+ */
+struct _internal_deque {
+    uint8_t** map;
+    size_t map_capacity;
+    size_t start;
+    size_t size;
+    size_t elements_size;
+    size_t block_shift;
+    size_t block_mask;
+    uint8_t* spare;     // Last emptied block, reused before calling malloc again.
+};
+/*
+ * Check if a deque and it's elements are not null.
+ */
+static bool deque_status(deque_t* const self) {
+    return self && self->size;
+}
+
+static uint8_t* deque_slot(deque_t* const self, const size_t position) {
+    return self->map[position >> self->block_shift] + (position & self->block_mask) * self->elements_size;
+}
+/*
+ * Unlink an emptied block, keeping it as the spare if there is none yet.
+ */
+static void deque_release_block(deque_t* const self, const size_t block) {
+    if (self->spare) {
+        free(self->map[block]);
+    }
+    else {
+        self->spare = self->map[block];
+    }
+    self->map[block] = NULL;
+}
+/*
+ * Release the blocks holding the elements and park start in the middle of
+ * the map so both ends have room to grow. Only blocks under the elements
+ * are ever allocated, so the rest of the map is never scanned.
+ */
+static void deque_reset(deque_t* const self) {
+    if (self->size) {
+        const size_t last = (self->start + self->size - 1) >> self->block_shift;
+        for (size_t i = self->start >> self->block_shift; i <= last; ++i) {
+            deque_release_block(self, i);
+        }
+    }
+    self->size = 0;
+    self->start = (self->map_capacity / 2) << self->block_shift;
+}
+/*
+ * Make sure the map has a free slot before the first used block (front) or
+ * after the last one. Only block pointers move, elements stay where they are.
+ */
+static bool deque_map_room(deque_t* const self, const bool front) {
+    const size_t first = self->start >> self->block_shift;
+    const size_t used = self->size ? ((self->start + self->size - 1) >> self->block_shift) - first + 1 : 0;
+    if (front ? first > 0 : first + used < self->map_capacity) {
+        return true;
+    }
+    size_t capacity = self->map_capacity;
+    if ((used + 1) * 2 > capacity) {
+        capacity = capacity * 2 > _MIN_MAP_BLOCKS_ ? capacity * 2 : _MIN_MAP_BLOCKS_;
+    }
+    uint8_t** map = self->map;
+    if (capacity != self->map_capacity) {
+        map = calloc(capacity, sizeof(uint8_t*));
+        if (!map) {
+            return false;
+        }
+    }
+    const size_t new_first = (capacity - used) / 2;
+    memmove(map + new_first, self->map + first, used * sizeof(uint8_t*));
+    if (map == self->map) {
+        for (size_t i = 0; i < capacity; ++i) {
+            if (i < new_first || i >= new_first + used) {
+                map[i] = NULL;
+            }
+        }
+    }
+    else {
+        free(self->map);
+    }
+    self->map = map;
+    self->map_capacity = capacity;
+    self->start = (new_first << self->block_shift) + (self->start & self->block_mask);
+    return true;
+}
+
+static bool deque_block(deque_t* const self, const size_t position) {
+    uint8_t** const block = &self->map[position >> self->block_shift];
+    if (!*block) {
+        *block = self->spare ? self->spare : malloc((self->block_mask + 1) * self->elements_size);
+        self->spare = NULL;
+    }
+    return *block != NULL;
+}
+///////////
+// Basic //
+///////////
+/**
+ * @brief Initialize a new deque container.
+ *
+ * @param elements_size What kind of variables is going to hold the deque container.
+ *
+ * @return A new deque container.
+ */
+deque_t* deque_init(const size_t elements_size) {
+    if (!elements_size) {
+        return NULL;
+    }
+    deque_t* init = malloc(sizeof(deque_t));
+    if (!init) {
+        return NULL;
+    }
+    init->map = calloc(_MIN_MAP_BLOCKS_, sizeof(uint8_t*));
+    if (!init->map) {
+        free(init);
+        return NULL;
+    }
+    size_t block_elements = _MIN_BLOCK_ELEMENTS_;
+    init->block_shift = 4;
+    while (block_elements * 2 * elements_size <= _BLOCK_BYTES_) {
+        block_elements *= 2;
+        init->block_shift++;
+    }
+    init->block_mask = block_elements - 1;
+    init->map_capacity = _MIN_MAP_BLOCKS_;
+    init->elements_size = elements_size;
+    init->spare = NULL;
+    init->size = 0;
+    deque_reset(init);
+    return init;
+}
+/**
+ * @brief Free the memory of a deque content plus container itself.
+ *
+ * @param self The deque to be freed.
+ */
+void deque_destroy(deque_t* const self) {
+    if (!self) {
+        return;
+    }
+    deque_reset(self);
+    free(self->spare);
+    free(self->map);
+    free(self);
+}
+////////////
+// Access //
+////////////
+/**
+ * @brief Returns a element from a deque container at given position.
+ *
+ * The address stays valid until that element is popped, whatever is pushed
+ * at either end meanwhile.
+ *
+ * @param self  Deque container to get element from.
+ * @param index Position at which get element from a deque container. Start point is 0.
+ *
+ * @return Return a element from self at index, or NULL if index is out of range.
+ */
+void* deque_at(deque_t* const self, const size_t index) {
+    if (!deque_status(self) || index >= self->size) {
+        return NULL;
+    }
+    return deque_slot(self, self->start + index);
+}
+/**
+ * @brief Return the last element in a deque container.
+ *
+ * @param self Deque container to get last element from.
+ *
+ * @return Return the last element in self.
+ */
+void* deque_back(deque_t* const self) {
+    if (!deque_status(self)) {
+        return NULL;
+    }
+    return deque_slot(self, self->start + self->size - 1);
+}
+/**
+ * @brief Return the first element in a deque container.
+ *
+ * @param self Deque container to get first element from.
+ *
+ * @return Return the first element in self.
+ */
+void* deque_front(deque_t* const self) {
+    if (!deque_status(self)) {
+        return NULL;
+    }
+    return deque_slot(self, self->start);
+}
+//////////////
+// Capacity //
+//////////////
+/**
+ * @brief Returns if a deque container has any elements at all.
+ *
+ * @param self Deque container to check size from.
+ *
+ * @return Return true if self has 0 size.
+ */
+bool deque_is_empty(deque_t* const self) {
+    return self ? self->size == 0 : true;
+}
+/**
+ * @brief Returns the current size of a deque container.
+ *
+ * @param self Deque container to retrieve size from.
+ *
+ * @return Return the current size of self.
+ */
+size_t deque_size(deque_t* const self) {
+    if (!self) {
+        return 0;
+    }
+    return self->size;
+}
+////////////////
+// Operations //
+////////////////
+/**
+ * @brief Remove all elements from a deque container.
+ *
+ * @param self Deque container whose elements are going to be removed.
+ */
+void deque_clear(deque_t* const self) {
+    if (!self) {
+        return;
+    }
+    deque_reset(self);
+}
+/**
+ * @brief Copy the content from a deque container to another one.
+ *
+ * @param dst Deque container that will recieve the copied elements.
+ * @param src Deque container whose elements will be copied.
+ *
+ * @return Return dst containing a copy of all elements in src.
+ */
+deque_t* deque_copy(deque_t* dst, deque_t* const src) {
+    if (!src || dst == src) {
+        return NULL;
+    }
+    if (!dst) {
+        dst = deque_init(src->elements_size);
+        if (!dst) {
+            return NULL;
+        }
+    }
+    else if (dst->elements_size != src->elements_size) {
+        return NULL;
+    }
+    else {
+        deque_clear(dst);
+    }
+    // Copy the longest run that stays inside one source block and one destination block.
+    while (dst->size < src->size) {
+        if (!((dst->start + dst->size) & dst->block_mask) && !deque_map_room(dst, false)) {
+            break;
+        }
+        const size_t from = src->start + dst->size;
+        const size_t to = dst->start + dst->size;
+        if (!deque_block(dst, to)) {
+            break;
+        }
+        size_t run = src->block_mask + 1 - (from & src->block_mask);
+        if (run > dst->block_mask + 1 - (to & dst->block_mask)) {
+            run = dst->block_mask + 1 - (to & dst->block_mask);
+        }
+        if (run > src->size - dst->size) {
+            run = src->size - dst->size;
+        }
+        memcpy(deque_slot(dst, to), deque_slot(src, from), run * src->elements_size);
+        dst->size += run;
+    }
+    return dst;
+}
+/**
+ * @brief Remove last element in a deque container.
+ *
+ * @param self Deque container whose last element will be removed.
+ */
+void deque_pop_back(deque_t* const self) {
+    if (!deque_status(self)) {
+        return;
+    }
+    if (self->size == 1) {
+        // Only the block of the last element is left to release.
+        deque_reset(self);
+        return;
+    }
+    self->size--;
+    const size_t end = self->start + self->size;
+    if (!(end & self->block_mask)) {
+        deque_release_block(self, end >> self->block_shift);
+    }
+}
+/**
+ * @brief Remove first element in a deque container.
+ *
+ * @param self Deque container whose first element will be removed.
+ */
+void deque_pop_front(deque_t* const self) {
+    if (!deque_status(self)) {
+        return;
+    }
+    if (self->size == 1) {
+        // Only the block of the last element is left to release.
+        deque_reset(self);
+        return;
+    }
+    self->size--;
+    const size_t block = self->start >> self->block_shift;
+    self->start++;
+    if (!(self->start & self->block_mask)) {
+        deque_release_block(self, block);
+    }
+}
+/**
+ * @brief Push a element at deque container end.
+ *
+ * @param self          Deque container that will hold the new element.
+ * @param element       Element to be added.
+ * @param element_size  Element size, must match the deque elements size.
+ */
+void deque_push_back(deque_t* const self, const void* const element, const size_t element_size) {
+    if (!self || !element || element_size != self->elements_size || self->size == SIZE_MAX) {
+        return;
+    }
+    if (!((self->start + self->size) & self->block_mask) && !deque_map_room(self, false)) {
+        return;
+    }
+    const size_t position = self->start + self->size;
+    if (!deque_block(self, position)) {
+        return;
+    }
+    memcpy(deque_slot(self, position), element, self->elements_size);
+    self->size++;
+}
+/**
+ * @brief Push a element at deque container front.
+ *
+ * @param self          Deque container that will hold the new element.
+ * @param element       Element to be added.
+ * @param element_size  Element size, must match the deque elements size.
+ */
+void deque_push_front(deque_t* const self, const void* const element, const size_t element_size) {
+    if (!self || !element || element_size != self->elements_size || self->size == SIZE_MAX) {
+        return;
+    }
+    if (!(self->start & self->block_mask) && !deque_map_room(self, true)) {
+        return;
+    }
+    const size_t position = self->start - 1;
+    if (!deque_block(self, position)) {
+        return;
+    }
+    memcpy(deque_slot(self, position), element, self->elements_size);
+    self->start = position;
+    self->size++;
+}
+/**
+ * @brief Swap the content of two deque containers.
+ *
+ * @param dst Deque container that will hold the swapped content.
+ * @param src Deque container whose content will be swapped.
+ */
+void deque_swap(deque_t* const dst, deque_t* const src) {
+    if (!dst || !src) {
+        return;
+    }
+    deque_t temp = *dst;
+    *dst = *src;
+    *src = temp;
+}
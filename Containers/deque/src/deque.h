@@ -0,0 +1,59 @@
+/*
+MIT License
+
+Copyright (c) 2018 Joseph Ojeda
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef DEQUE_H
+#define DEQUE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+typedef struct _internal_deque deque_t;
+///////////
+// Basic //
+///////////
+deque_t*    deque_init(const size_t elements_size);
+void        deque_destroy(deque_t* const self);
+////////////
+// Access //
+////////////
+void*       deque_at(deque_t* const self, const size_t index);
+void*       deque_back(deque_t* const self);
+void*       deque_front(deque_t* const self);
+//////////////
+// Capacity //
+//////////////
+bool        deque_is_empty(deque_t* const self);
+size_t      deque_size(deque_t* const self);
+/////////////////
+// Operations //
+////////////////
+void        deque_clear(deque_t* const self);
+deque_t*    deque_copy(deque_t* dst, deque_t* const src);
+void        deque_pop_back(deque_t* const self);
+void        deque_pop_front(deque_t* const self);
+void        deque_push_back(deque_t* const self, const void* const element, const size_t element_size);
+void        deque_push_front(deque_t* const self, const void* const element, const size_t element_size);
+void        deque_swap(deque_t* const dst, deque_t* const src);
+
+#endif
@@ -0,0 +1,65 @@
+/*
+MIT License
+
+Copyright (c) 2018 Joseph Ojeda
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "./src/deque.h"
+
+int main(void) {
+    deque_t* deque1 = deque_init(sizeof(int));
+    printf("deque1.size = %ld\n", deque_size(deque1));
+    printf("deque1.front = %p\n", deque_front(deque1));
+    for (int i = 0; i < 1000; ++i) {
+        deque_push_back(deque1, &i, sizeof(int));
+    }
+    int* first = deque_front(deque1);
+    for (int i = -1; i >= -1000; --i) {
+        deque_push_front(deque1, &i, sizeof(int));
+    }
+    printf("\ndeque1.size = %ld\n", deque_size(deque1));
+    printf("deque1.front = %d\n", *(int*)(deque_front(deque1)));
+    printf("deque1.back = %d\n", *(int*)(deque_back(deque1)));
+    printf("deque1.at(1000) = %d\n", *(int*)(deque_at(deque1, 1000)));
+    printf("deque1.at(1000) == first = %d\n", deque_at(deque1, 1000) == first);
+
+    for (int i = 0; i < 500; ++i) {
+        deque_pop_front(deque1);
+        deque_pop_back(deque1);
+    }
+    printf("\ndeque1.size = %ld\n", deque_size(deque1));
+    printf("deque1.front = %d\n", *(int*)(deque_front(deque1)));
+    printf("deque1.back = %d\n", *(int*)(deque_back(deque1)));
+
+    deque_t* deque2 = deque_copy(NULL, deque1);
+    deque_clear(deque1);
+    printf("\ndeque1.size = %ld\n", deque_size(deque1));
+    printf("deque2.size = %ld\n", deque_size(deque2));
+    printf("deque2.at(500) = %d\n", *(int*)(deque_at(deque2, 500)));
+
+    deque_destroy(deque1);
+    deque_destroy(deque2);
+
+    return EXIT_SUCCESS;
+}
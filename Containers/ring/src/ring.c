@@ -0,0 +1,341 @@
+/*
+MIT License
+
+Copyright (c) 2018 Joseph Ojeda
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <stdatomic.h>  // atomic_size_t, atomic_load_explicit
+#include <stdlib.h>     // malloc, aligned_alloc, free
+#include <string.h>     // memcpy
+
+#include "./ring.h"
+
+#define _MIN_CAPACITY_ 2
+
+/*
+ * head and tail count elements ever popped and pushed; slot i lives at
+ * i & mask. Producer and consumer sides sit on their own cache lines and
+ * keep a cached copy of the other side's counter, refreshed only when the
+ * cached value says the ring is full or empty. In RING_MPSC mode producers
+ * claim [reserve, reserve + n) first, then publish each of their slots on
+ * its own: slot i holds position p once sequences[i] == p + 1. No producer
+ * ever waits on another one, the consumer stops at the first slot still
+ * being written.
+ */
+struct _internal_ring {
+    uint8_t* elements;
+    size_t elements_size;
+    size_t capacity;
+    size_t mask;
+    ring_mode mode;
+    atomic_size_t* sequences;   // RING_MPSC only.
+    _Alignas(64) atomic_size_t reserve;
+    atomic_size_t tail;
+    size_t producer_head;
+    _Alignas(64) atomic_size_t head;
+    size_t consumer_tail;
+};
+/*
+ * Check if a ring and it's elements are not null.
+ */
+static bool ring_status(ring_t* const self) {
+    return self && self->elements;
+}
+/*
+ * Copy count elements into the ring from position, wrapping around its end.
+ */
+static void ring_write(ring_t* const self, const size_t position, const uint8_t* const elements, const size_t count) {
+    const size_t index = position & self->mask;
+    const size_t first = count < self->capacity - index ? count : self->capacity - index;
+    memcpy(self->elements + index * self->elements_size, elements, first * self->elements_size);
+    memcpy(self->elements, elements + first * self->elements_size, (count - first) * self->elements_size);
+}
+/*
+ * Copy count elements out of the ring from position, wrapping around its end.
+ */
+static void ring_read(ring_t* const self, const size_t position, uint8_t* const elements, const size_t count) {
+    const size_t index = position & self->mask;
+    const size_t first = count < self->capacity - index ? count : self->capacity - index;
+    memcpy(elements, self->elements + index * self->elements_size, first * self->elements_size);
+    memcpy(elements + first * self->elements_size, self->elements, (count - first) * self->elements_size);
+}
+/*
+ * Claim up to count free slots for a single producer, returning how many.
+ */
+static size_t ring_claim_single(ring_t* const self, const size_t count, size_t* const start) {
+    *start = atomic_load_explicit(&self->tail, memory_order_relaxed);
+    size_t free = self->capacity - (*start - self->producer_head);
+    if (free < count) {
+        self->producer_head = atomic_load_explicit(&self->head, memory_order_acquire);
+        free = self->capacity - (*start - self->producer_head);
+    }
+    return count < free ? count : free;
+}
+/*
+ * Claim up to count free slots among many producers, returning how many.
+ */
+static size_t ring_claim_multi(ring_t* const self, const size_t count, size_t* const start) {
+    *start = atomic_load_explicit(&self->reserve, memory_order_relaxed);
+    size_t claimed = 0;
+    do {
+        const size_t head = atomic_load_explicit(&self->head, memory_order_acquire);
+        const size_t free = self->capacity - (*start - head);
+        claimed = count < free ? count : free;
+        if (!claimed) {
+            return 0;
+        }
+    } while (!atomic_compare_exchange_weak_explicit(&self->reserve, start, *start + claimed, memory_order_relaxed, memory_order_relaxed));
+    return claimed;
+}
+/*
+ * Publish every claimed slot, independently of other producers.
+ */
+static void ring_publish_multi(ring_t* const self, const size_t start, const size_t count) {
+    for (size_t position = start; position < start + count; ++position) {
+        atomic_store_explicit(&self->sequences[position & self->mask], position + 1, memory_order_release);
+    }
+}
+/*
+ * Count the published slots from head on, up to count, for the consumer.
+ */
+static size_t ring_available_multi(ring_t* const self, const size_t head, const size_t count) {
+    size_t available = 0;
+    while (available < count &&
+           atomic_load_explicit(&self->sequences[(head + available) & self->mask], memory_order_acquire) == head + available + 1) {
+        ++available;
+    }
+    return available;
+}
+///////////
+// Basic //
+///////////
+/**
+ * @brief Initialize a new ring container.
+ *
+ * @param elements_size What kind of variables is going to hold the ring.
+ * @param capacity      How many elements the ring holds, rounded up to a power of two.
+ * @param mode          RING_SPSC for one producer thread, RING_MPSC for many.
+ *
+ * @return A new ring container.
+ */
+ring_t* ring_init(const size_t elements_size, const size_t capacity, const ring_mode mode) {
+    if (!elements_size || !capacity || capacity > SIZE_MAX / 2 / elements_size || (mode != RING_SPSC && mode != RING_MPSC)) {
+        return NULL;
+    }
+    ring_t* init = aligned_alloc(64, sizeof(ring_t));
+    if (!init) {
+        return NULL;
+    }
+    init->capacity = _MIN_CAPACITY_;
+    while (init->capacity < capacity) {
+        init->capacity <<= 1;
+    }
+    init->elements = malloc(init->capacity * elements_size);
+    init->sequences = mode == RING_MPSC ? malloc(init->capacity * sizeof(atomic_size_t)) : NULL;
+    if (!init->elements || (mode == RING_MPSC && !init->sequences)) {
+        free(init->elements);
+        free(init->sequences);
+        free(init);
+        return NULL;
+    }
+    for (size_t i = 0; init->sequences && i < init->capacity; ++i) {
+        atomic_init(&init->sequences[i], 0);
+    }
+    init->elements_size = elements_size;
+    init->mask = init->capacity - 1;
+    init->mode = mode;
+    atomic_init(&init->reserve, 0);
+    atomic_init(&init->tail, 0);
+    init->producer_head = 0;
+    atomic_init(&init->head, 0);
+    init->consumer_tail = 0;
+    return init;
+}
+/**
+ * @brief Free the elements of a ring container plus the container itself. No other thread may use it anymore.
+ *
+ * @param self The ring container to be freed.
+ */
+void ring_destroy(ring_t* const self) {
+    if (!self) {
+        return;
+    }
+    free(self->elements);
+    free(self->sequences);
+    free(self);
+}
+//////////////
+// Capacity //
+//////////////
+/**
+ * @brief Returns how many elements a ring container holds at most.
+ *
+ * @param self Ring container to retrieve capacity from.
+ *
+ * @return Return the capacity of self.
+ */
+size_t ring_capacity(ring_t* const self) {
+    if (!ring_status(self)) {
+        return 0;
+    }
+    return self->capacity;
+}
+/**
+ * @brief Returns the size of the elements of a ring container.
+ *
+ * @param self Ring container to retrieve elements size from.
+ *
+ * @return Return the elements size of self.
+ */
+size_t ring_elements_size(ring_t* const self) {
+    if (!ring_status(self)) {
+        return 0;
+    }
+    return self->elements_size;
+}
+/**
+ * @brief Returns if a ring container holds no published element.
+ *
+ * @param self Ring container to check size from.
+ *
+ * @return Return true if self is empty. Only a hint while other threads use it.
+ */
+bool ring_is_empty(ring_t* const self) {
+    if (ring_status(self) && self->mode == RING_MPSC) {
+        return !ring_available_multi(self, atomic_load_explicit(&self->head, memory_order_acquire), 1);
+    }
+    return ring_size(self) == 0;
+}
+/**
+ * @brief Returns if a ring container has no free slot.
+ *
+ * @param self Ring container to check size from.
+ *
+ * @return Return true if self is full. Only a hint while other threads use it.
+ */
+bool ring_is_full(ring_t* const self) {
+    return ring_status(self) && ring_size(self) == self->capacity;
+}
+/**
+ * @brief Returns how many published elements a ring container holds.
+ *
+ * @param self Ring container to retrieve size from.
+ *
+ * @return Return the size of self. Only a hint while other threads use it. In RING_MPSC
+ *         mode it also counts slots claimed by producers still writing them.
+ */
+size_t ring_size(ring_t* const self) {
+    if (!ring_status(self)) {
+        return 0;
+    }
+    const size_t head = atomic_load_explicit(&self->head, memory_order_acquire);
+    const size_t tail = atomic_load_explicit(self->mode == RING_MPSC ? &self->reserve : &self->tail, memory_order_acquire);
+    return tail - head <= self->capacity ? tail - head : 0;
+}
+/////////////////
+// Operations //
+////////////////
+/**
+ * @brief Remove the oldest element of a ring container. Consumer thread only.
+ *
+ * @param self      Ring container whose oldest element will be removed.
+ * @param element   Receives the removed element, elements size bytes.
+ *
+ * @return Return true if an element was removed, false if self was empty.
+ */
+bool ring_pop(ring_t* const self, void* const element) {
+    return ring_pop_n(self, element, 1) == 1;
+}
+/**
+ * @brief Remove up to element_count of the oldest elements of a ring container. Consumer thread only.
+ *
+ * @param self          Ring container whose oldest elements will be removed.
+ * @param elements      Receives the removed elements, in order, back to back.
+ * @param element_count How many elements will be removed at most.
+ *
+ * @return Return how many elements were removed.
+ */
+size_t ring_pop_n(ring_t* const self, void* const elements, const size_t element_count) {
+    if (!ring_status(self) || !elements || !element_count) {
+        return 0;
+    }
+    const size_t head = atomic_load_explicit(&self->head, memory_order_relaxed);
+    size_t available = 0;
+    if (self->mode == RING_MPSC) {
+        available = ring_available_multi(self, head, element_count);
+    }
+    else {
+        available = self->consumer_tail - head;
+        if (available < element_count) {
+            self->consumer_tail = atomic_load_explicit(&self->tail, memory_order_acquire);
+            available = self->consumer_tail - head;
+        }
+    }
+    const size_t count = element_count < available ? element_count : available;
+    if (!count) {
+        return 0;
+    }
+    ring_read(self, head, elements, count);
+    atomic_store_explicit(&self->head, head + count, memory_order_release);
+    return count;
+}
+/**
+ * @brief Add a element at the end of a ring container.
+ *
+ * @param self          Ring container that will hold the new element.
+ * @param element       Element to be added.
+ * @param element_size  Element size, must match the ring elements size.
+ *
+ * @return Return true if the element was added, false if self was full.
+ */
+bool ring_push(ring_t* const self, const void* const element, const size_t element_size) {
+    return ring_push_n(self, element, element_size, 1) == 1;
+}
+/**
+ * @brief Add up to element_count elements at the end of a ring container, as one batch.
+ *
+ * @param self          Ring container that will hold the new elements.
+ * @param elements      Pointer to the first of element_count contiguous elements.
+ * @param element_size  Size of each element, must match the ring elements size.
+ * @param element_count How many elements will be added at most.
+ *
+ * @return Return how many elements were added, fewer than element_count when self fills up.
+ */
+size_t ring_push_n(ring_t* const self, const void* const elements, const size_t element_size, const size_t element_count) {
+    if (!ring_status(self) || !elements || element_size != self->elements_size || !element_count) {
+        return 0;
+    }
+    size_t start = 0;
+    if (self->mode == RING_SPSC) {
+        const size_t count = ring_claim_single(self, element_count, &start);
+        if (count) {
+            ring_write(self, start, elements, count);
+            atomic_store_explicit(&self->tail, start + count, memory_order_release);
+        }
+        return count;
+    }
+    const size_t count = ring_claim_multi(self, element_count, &start);
+    if (count) {
+        ring_write(self, start, elements, count);
+        ring_publish_multi(self, start, count);
+    }
+    return count;
+}
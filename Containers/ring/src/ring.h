@@ -0,0 +1,67 @@
+/*
+MIT License
+
+Copyright (c) 2018 Joseph Ojeda
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef RING_H
+#define RING_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+ * Who may call ring_push/ring_push_n concurrently. In both modes a single
+ * consumer thread calls ring_pop/ring_pop_n.
+ */
+typedef enum ring_mode {
+    RING_SPSC,  // One producer thread, fully wait-free.
+    RING_MPSC   // Many producer threads, lock-free: slots are claimed with a compare-and-swap
+                // and each producer publishes its own. A stalled producer only holds back
+                // the consumer once it reaches that producer's slots.
+} ring_mode;
+
+/*
+ * Lock-free bounded FIFO over a power-of-two array of elements_size slots.
+ */
+typedef struct _internal_ring ring_t;
+///////////
+// Basic //
+///////////
+ring_t*     ring_init(const size_t elements_size, const size_t capacity, const ring_mode mode);
+void        ring_destroy(ring_t* const self);
+//////////////
+// Capacity //
+//////////////
+size_t      ring_capacity(ring_t* const self);
+size_t      ring_elements_size(ring_t* const self);
+bool        ring_is_empty(ring_t* const self);
+bool        ring_is_full(ring_t* const self);
+size_t      ring_size(ring_t* const self);
+/////////////////
+// Operations //
+////////////////
+bool        ring_pop(ring_t* const self, void* const element);
+size_t      ring_pop_n(ring_t* const self, void* const elements, const size_t element_count);
+bool        ring_push(ring_t* const self, const void* const element, const size_t element_size);
+size_t      ring_push_n(ring_t* const self, const void* const elements, const size_t element_size, const size_t element_count);
+
+#endif
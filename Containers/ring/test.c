@@ -0,0 +1,62 @@
+/*
+MIT License
+
+Copyright (c) 2018 Joseph Ojeda
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "./src/ring.h"
+
+int main(void) {
+    ring_t* ring1 = ring_init(sizeof(int), 100, RING_SPSC);
+    printf("ring1.capacity = %ld\n", ring_capacity(ring1));
+    printf("ring1.is_empty = %d\n", ring_is_empty(ring1));
+    for (int i = 0; ring_push(ring1, &i, sizeof(int)); ++i) {
+    }
+    printf("\nring1.size = %ld\n", ring_size(ring1));
+    printf("ring1.is_full = %d\n", ring_is_full(ring1));
+
+    int batch[50];
+    printf("\nring_pop_n(ring1, 50) = %ld\n", ring_pop_n(ring1, batch, 50));
+    printf("batch[0] = %d, batch[49] = %d\n", batch[0], batch[49]);
+    for (int i = 0; i < 50; ++i) {
+        batch[i] = 1000 + i;
+    }
+    printf("ring_push_n(ring1, 50) = %ld\n", ring_push_n(ring1, batch, sizeof(int), 50));
+    printf("ring_push_n(ring1, 50) = %ld\n", ring_push_n(ring1, batch, sizeof(int), 50));
+
+    int element = 0;
+    while (ring_pop(ring1, &element)) {
+    }
+    printf("\nlast popped = %d\n", element);
+    printf("ring1.size = %ld\n", ring_size(ring1));
+
+    ring_t* ring2 = ring_init(sizeof(int), 16, RING_MPSC);
+    printf("\nring_push_n(ring2, 50) = %ld\n", ring_push_n(ring2, batch, sizeof(int), 50));
+    printf("ring2.size = %ld\n", ring_size(ring2));
+
+    ring_destroy(ring1);
+    ring_destroy(ring2);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,645 @@
+/*
+MIT License
+
+Copyright (c) 2018 Joseph Ojeda
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <pthread.h>    // pthread_create, pthread_join, pthread_mutex_t, pthread_cond_t
+#include <sched.h>      // sched_yield
+#include <stdatomic.h>  // atomic_size_t, atomic_thread_fence
+#include <stdlib.h>     // malloc, calloc, aligned_alloc, free
+#include <unistd.h>     // sysconf
+
+#include "./scheduler.h"
+
+#define _CACHE_LINE_ 64
+#define _DEQUE_CAPACITY_ 256
+#define _INJECT_CAPACITY_ 64
+#define _SPIN_LIMIT_ 16
+#define _YIELD_LIMIT_ 48
+#define _LOOP_SPLITS_ 8
+
+typedef void (*scheduler_function)(void* const context);
+
+/*
+ * A unit of work. Submitted tasks call function(context); loop tasks have
+ * no function, context points to their scheduler_loop and [begin, end) is
+ * the part of the range they cover.
+ */
+typedef struct scheduler_task {
+    scheduler_function function;
+    void* context;
+    size_t begin;
+    size_t end;
+} scheduler_task;
+
+/*
+ * Deque slots are atomic field by field: a thief may read a slot the owner
+ * is rewriting, its compare-and-swap on top then fails and the torn copy
+ * is dropped.
+ */
+typedef struct scheduler_slot {
+    _Atomic(scheduler_function) function;
+    _Atomic(void*) context;
+    atomic_size_t begin;
+    atomic_size_t end;
+} scheduler_slot;
+
+/*
+ * Circular buffer of a deque. A full buffer is replaced by one twice as
+ * large; the old one stays alive until the scheduler is destroyed since
+ * thieves may still be reading it.
+ */
+typedef struct scheduler_array {
+    struct scheduler_array* previous;
+    size_t mask;
+    scheduler_slot slots[];
+} scheduler_array;
+
+/*
+ * Chase-Lev deque. Only its owner moves bottom, thieves race for top with
+ * a compare-and-swap, and the owner joins that race for the last task.
+ */
+typedef struct scheduler_deque {
+    _Alignas(_CACHE_LINE_) _Atomic int64_t top;
+    _Alignas(_CACHE_LINE_) _Atomic int64_t bottom;
+    _Atomic(scheduler_array*) array;
+} scheduler_deque;
+
+typedef struct scheduler_loop {
+    void (*body)(const size_t begin, const size_t end, void* const context);
+    void* context;
+    size_t grain;
+    atomic_size_t remaining;    // Iterations not run yet.
+} scheduler_loop;
+
+struct _internal_scheduler {
+    pthread_t* threads;
+    scheduler_deque* deques;    // One per worker plus one lent to an outside thread.
+    size_t threads_count;
+    pthread_mutex_t caller;     // Held by the outside thread owning the last deque.
+    pthread_mutex_t inject_lock;
+    scheduler_task* injected;
+    size_t inject_head;
+    size_t inject_size;
+    size_t inject_capacity;
+    atomic_size_t inject_count;
+    _Alignas(_CACHE_LINE_) atomic_size_t pending;   // Submitted tasks not finished yet.
+    _Alignas(_CACHE_LINE_) atomic_size_t sleepers;
+    pthread_mutex_t lock;
+    pthread_cond_t wake;
+    size_t posted;
+    atomic_bool stop;
+};
+
+typedef struct scheduler_entry {
+    scheduler_t* scheduler;
+    scheduler_deque* deque;
+    bool entered;
+} scheduler_entry;
+
+typedef struct scheduler_worker {
+    scheduler_t* scheduler;
+    size_t id;
+} scheduler_worker;
+
+static _Thread_local scheduler_t* current_scheduler = NULL;
+static _Thread_local scheduler_deque* current_deque = NULL;
+
+static uint64_t scheduler_random(uint64_t* const seed) {
+    *seed ^= *seed << 13;
+    *seed ^= *seed >> 7;
+    *seed ^= *seed << 17;
+    return *seed;
+}
+/*
+ * Spin with pause hints first, then yield the CPU.
+ */
+static void scheduler_backoff(unsigned* const idle) {
+    if (*idle < _SPIN_LIMIT_) {
+        const unsigned spins = 1u << (*idle < 6 ? *idle : 6);
+        for (unsigned i = 0; i < spins; ++i) {
+#if defined(__x86_64__) || defined(__i386__)
+            __builtin_ia32_pause();
+#else
+            atomic_signal_fence(memory_order_seq_cst);
+#endif
+        }
+    } else {
+        sched_yield();
+    }
+    ++*idle;
+}
+
+static scheduler_array* scheduler_array_new(const size_t capacity, scheduler_array* const previous) {
+    scheduler_array* array = malloc(sizeof(scheduler_array) + capacity * sizeof(scheduler_slot));
+    if (!array) {
+        return NULL;
+    }
+    array->previous = previous;
+    array->mask = capacity - 1;
+    return array;
+}
+
+static void scheduler_slot_store(scheduler_slot* const slot, const scheduler_task* const task) {
+    atomic_store_explicit(&slot->function, task->function, memory_order_relaxed);
+    atomic_store_explicit(&slot->context, task->context, memory_order_relaxed);
+    atomic_store_explicit(&slot->begin, task->begin, memory_order_relaxed);
+    atomic_store_explicit(&slot->end, task->end, memory_order_relaxed);
+}
+
+static void scheduler_slot_load(scheduler_slot* const slot, scheduler_task* const task) {
+    task->function = atomic_load_explicit(&slot->function, memory_order_relaxed);
+    task->context = atomic_load_explicit(&slot->context, memory_order_relaxed);
+    task->begin = atomic_load_explicit(&slot->begin, memory_order_relaxed);
+    task->end = atomic_load_explicit(&slot->end, memory_order_relaxed);
+}
+/*
+ * Owner only. Fails only if a full buffer cannot grow.
+ */
+static bool deque_push(scheduler_deque* const deque, const scheduler_task* const task) {
+    const int64_t bottom = atomic_load_explicit(&deque->bottom, memory_order_relaxed);
+    const int64_t top = atomic_load_explicit(&deque->top, memory_order_acquire);
+    scheduler_array* array = atomic_load_explicit(&deque->array, memory_order_relaxed);
+    if ((size_t)(bottom - top) > array->mask) {
+        scheduler_array* grown = scheduler_array_new((array->mask + 1) * 2, array);
+        if (!grown) {
+            return false;
+        }
+        for (int64_t i = top; i < bottom; ++i) {
+            scheduler_task moved;
+            scheduler_slot_load(&array->slots[(size_t)i & array->mask], &moved);
+            scheduler_slot_store(&grown->slots[(size_t)i & grown->mask], &moved);
+        }
+        atomic_store_explicit(&deque->array, grown, memory_order_release);
+        array = grown;
+    }
+    scheduler_slot_store(&array->slots[(size_t)bottom & array->mask], task);
+    atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_release);
+    return true;
+}
+/*
+ * Owner only, takes the most recently pushed task.
+ */
+static bool deque_pop(scheduler_deque* const deque, scheduler_task* const task) {
+    const int64_t bottom = atomic_load_explicit(&deque->bottom, memory_order_relaxed) - 1;
+    scheduler_array* const array = atomic_load_explicit(&deque->array, memory_order_relaxed);
+    atomic_store_explicit(&deque->bottom, bottom, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+    int64_t top = atomic_load_explicit(&deque->top, memory_order_relaxed);
+    if (top > bottom) {
+        atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_relaxed);
+        return false;
+    }
+    scheduler_slot_load(&array->slots[(size_t)bottom & array->mask], task);
+    if (top < bottom) {
+        return true;
+    }
+    // Last task: whoever moves top first gets it.
+    const bool taken = atomic_compare_exchange_strong_explicit(&deque->top, &top, top + 1, memory_order_seq_cst, memory_order_relaxed);
+    atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_relaxed);
+    return taken;
+}
+/*
+ * Any thread, takes the oldest task. Losing a race counts as empty.
+ */
+static bool deque_steal(scheduler_deque* const deque, scheduler_task* const task) {
+    int64_t top = atomic_load_explicit(&deque->top, memory_order_acquire);
+    atomic_thread_fence(memory_order_seq_cst);
+    const int64_t bottom = atomic_load_explicit(&deque->bottom, memory_order_acquire);
+    if (top >= bottom) {
+        return false;
+    }
+    scheduler_array* const array = atomic_load_explicit(&deque->array, memory_order_acquire);
+    scheduler_slot_load(&array->slots[(size_t)top & array->mask], task);
+    return atomic_compare_exchange_strong_explicit(&deque->top, &top, top + 1, memory_order_seq_cst, memory_order_relaxed);
+}
+
+static bool deque_has_work(scheduler_deque* const deque) {
+    return atomic_load_explicit(&deque->top, memory_order_relaxed) < atomic_load_explicit(&deque->bottom, memory_order_relaxed);
+}
+/*
+ * Wake one sleeping worker, if any. The fence pairs with the one in
+ * scheduler_thread: either the pusher sees the sleeper, or the sleeper
+ * sees the pushed task.
+ */
+static void scheduler_notify(scheduler_t* const self) {
+    atomic_thread_fence(memory_order_seq_cst);
+    if (!atomic_load_explicit(&self->sleepers, memory_order_relaxed)) {
+        return;
+    }
+    pthread_mutex_lock(&self->lock);
+    self->posted++;
+    pthread_cond_signal(&self->wake);
+    pthread_mutex_unlock(&self->lock);
+}
+
+static bool scheduler_inject(scheduler_t* const self, const scheduler_task* const task) {
+    pthread_mutex_lock(&self->inject_lock);
+    if (self->inject_size == self->inject_capacity) {
+        const size_t capacity = self->inject_capacity ? self->inject_capacity * 2 : _INJECT_CAPACITY_;
+        scheduler_task* grown = malloc(capacity * sizeof(scheduler_task));
+        if (!grown) {
+            pthread_mutex_unlock(&self->inject_lock);
+            return false;
+        }
+        for (size_t i = 0; i < self->inject_size; ++i) {
+            grown[i] = self->injected[(self->inject_head + i) % self->inject_capacity];
+        }
+        free(self->injected);
+        self->injected = grown;
+        self->inject_head = 0;
+        self->inject_capacity = capacity;
+    }
+    self->injected[(self->inject_head + self->inject_size) % self->inject_capacity] = *task;
+    self->inject_size++;
+    atomic_fetch_add_explicit(&self->inject_count, 1, memory_order_relaxed);
+    pthread_mutex_unlock(&self->inject_lock);
+    return true;
+}
+
+static bool scheduler_take_injected(scheduler_t* const self, scheduler_task* const task) {
+    if (!atomic_load_explicit(&self->inject_count, memory_order_relaxed)) {
+        return false;
+    }
+    bool taken = false;
+    pthread_mutex_lock(&self->inject_lock);
+    if (self->inject_size) {
+        *task = self->injected[self->inject_head];
+        self->inject_head = (self->inject_head + 1) % self->inject_capacity;
+        self->inject_size--;
+        atomic_fetch_sub_explicit(&self->inject_count, 1, memory_order_relaxed);
+        taken = true;
+    }
+    pthread_mutex_unlock(&self->inject_lock);
+    return taken;
+}
+/*
+ * Queue a task on the calling thread's own deque when it has one, on the
+ * injection queue otherwise.
+ */
+static bool scheduler_push(scheduler_t* const self, const scheduler_task* const task) {
+    const bool pushed = (current_scheduler == self && current_deque && deque_push(current_deque, task)) || scheduler_inject(self, task);
+    if (pushed) {
+        scheduler_notify(self);
+    }
+    return pushed;
+}
+/*
+ * Own deque first, then the injection queue, then random victims.
+ */
+static bool scheduler_find(scheduler_t* const self, scheduler_deque* const own, uint64_t* const seed, scheduler_task* const task) {
+    if (own && deque_pop(own, task)) {
+        return true;
+    }
+    if (scheduler_take_injected(self, task)) {
+        return true;
+    }
+    const size_t deques_count = self->threads_count + 1;
+    for (size_t attempt = 0; attempt < deques_count * 2; ++attempt) {
+        scheduler_deque* const victim = &self->deques[scheduler_random(seed) % deques_count];
+        if (victim != own && deque_steal(victim, task)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool scheduler_has_work(scheduler_t* const self) {
+    if (atomic_load_explicit(&self->inject_count, memory_order_relaxed)) {
+        return true;
+    }
+    for (size_t i = 0; i <= self->threads_count; ++i) {
+        if (deque_has_work(&self->deques[i])) {
+            return true;
+        }
+    }
+    return false;
+}
+/*
+ * Split the range in halves, pushing the upper one for thieves, down to
+ * the loop grain, then run what is left. A thread without a deque runs the
+ * whole range.
+ */
+static void scheduler_loop_run(scheduler_t* const self, scheduler_deque* const own, scheduler_loop* const loop, const size_t begin, size_t end) {
+    while (own && end - begin > loop->grain) {
+        const size_t middle = begin + (end - begin) / 2;
+        const scheduler_task upper = { .function = NULL, .context = loop, .begin = middle, .end = end };
+        if (!deque_push(own, &upper)) {
+            break;
+        }
+        scheduler_notify(self);
+        end = middle;
+    }
+    loop->body(begin, end, loop->context);
+    // Last use of loop, its owner may return as soon as remaining hits 0.
+    atomic_fetch_sub_explicit(&loop->remaining, end - begin, memory_order_release);
+}
+
+static void scheduler_run(scheduler_t* const self, scheduler_deque* const own, const scheduler_task* const task) {
+    if (task->function) {
+        task->function(task->context);
+        atomic_fetch_sub_explicit(&self->pending, 1, memory_order_release);
+    } else {
+        scheduler_loop_run(self, own, task->context, task->begin, task->end);
+    }
+}
+/*
+ * Run tasks from the calling thread until counter drops to 0.
+ */
+static void scheduler_help(scheduler_t* const self, scheduler_deque* const own, atomic_size_t* const counter) {
+    uint64_t seed = (uint64_t)(uintptr_t)&seed | 1;
+    unsigned idle = 0;
+    scheduler_task task;
+    while (atomic_load_explicit(counter, memory_order_acquire)) {
+        if (scheduler_find(self, own, &seed, &task)) {
+            scheduler_run(self, own, &task);
+            idle = 0;
+        } else {
+            scheduler_backoff(&idle);
+        }
+    }
+}
+/*
+ * Lend the spare deque to an outside thread, if no one else holds it. The
+ * thread's previous scheduler, if any, is kept for scheduler_leave.
+ */
+static scheduler_deque* scheduler_enter(scheduler_t* const self, scheduler_entry* const entry) {
+    entry->entered = false;
+    if (current_scheduler == self) {
+        return current_deque;
+    }
+    if (pthread_mutex_trylock(&self->caller)) {
+        return NULL;
+    }
+    entry->entered = true;
+    entry->scheduler = current_scheduler;
+    entry->deque = current_deque;
+    current_scheduler = self;
+    current_deque = &self->deques[self->threads_count];
+    return current_deque;
+}
+
+static void scheduler_leave(scheduler_t* const self, const scheduler_entry* const entry) {
+    if (!entry->entered) {
+        return;
+    }
+    current_scheduler = entry->scheduler;
+    current_deque = entry->deque;
+    pthread_mutex_unlock(&self->caller);
+}
+
+static void* scheduler_thread(void* const argument) {
+    scheduler_worker* const worker = argument;
+    scheduler_t* const self = worker->scheduler;
+    scheduler_deque* const own = &self->deques[worker->id];
+    uint64_t seed = 0x9E3779B97F4A7C15u * (worker->id + 1);
+    free(worker);
+    current_scheduler = self;
+    current_deque = own;
+    unsigned idle = 0;
+    scheduler_task task;
+    while (!atomic_load_explicit(&self->stop, memory_order_relaxed)) {
+        if (scheduler_find(self, own, &seed, &task)) {
+            scheduler_run(self, own, &task);
+            idle = 0;
+            continue;
+        }
+        if (idle < _SPIN_LIMIT_ + _YIELD_LIMIT_) {
+            scheduler_backoff(&idle);
+            continue;
+        }
+        pthread_mutex_lock(&self->lock);
+        atomic_fetch_add_explicit(&self->sleepers, 1, memory_order_relaxed);
+        atomic_thread_fence(memory_order_seq_cst);
+        const size_t seen = self->posted;
+        while (!atomic_load_explicit(&self->stop, memory_order_relaxed) && self->posted == seen && !scheduler_has_work(self)) {
+            pthread_cond_wait(&self->wake, &self->lock);
+        }
+        atomic_fetch_sub_explicit(&self->sleepers, 1, memory_order_relaxed);
+        pthread_mutex_unlock(&self->lock);
+        idle = 0;
+    }
+    return NULL;
+}
+///////////
+// Basic //
+///////////
+/**
+ * @brief Initialize a new work-stealing scheduler.
+ *
+ * @param threads_count Worker threads to start, threads waiting on the scheduler also work. 0 uses one per online CPU but one.
+ *
+ * @return A new scheduler.
+ */
+scheduler_t* scheduler_init(const size_t threads_count) {
+    size_t count = threads_count;
+    if (!count) {
+        const long online = sysconf(_SC_NPROCESSORS_ONLN);
+        count = online > 1 ? (size_t)online - 1 : 0;
+    }
+    scheduler_t* init = malloc(sizeof(scheduler_t));
+    if (!init) {
+        return NULL;
+    }
+    init->threads = calloc(count ? count : 1, sizeof(pthread_t));
+    init->deques = aligned_alloc(_CACHE_LINE_, (count + 1) * sizeof(scheduler_deque));
+    if (!init->threads || !init->deques) {
+        free(init->threads);
+        free(init->deques);
+        free(init);
+        return NULL;
+    }
+    for (size_t i = 0; i <= count; ++i) {
+        scheduler_array* const array = scheduler_array_new(_DEQUE_CAPACITY_, NULL);
+        if (!array) {
+            for (size_t j = 0; j < i; ++j) {
+                free(atomic_load_explicit(&init->deques[j].array, memory_order_relaxed));
+            }
+            free(init->threads);
+            free(init->deques);
+            free(init);
+            return NULL;
+        }
+        atomic_init(&init->deques[i].top, 0);
+        atomic_init(&init->deques[i].bottom, 0);
+        atomic_init(&init->deques[i].array, array);
+    }
+    pthread_mutex_init(&init->caller, NULL);
+    pthread_mutex_init(&init->inject_lock, NULL);
+    init->injected = NULL;
+    init->inject_head = 0;
+    init->inject_size = 0;
+    init->inject_capacity = 0;
+    atomic_init(&init->inject_count, 0);
+    atomic_init(&init->pending, 0);
+    atomic_init(&init->sleepers, 0);
+    pthread_mutex_init(&init->lock, NULL);
+    pthread_cond_init(&init->wake, NULL);
+    init->posted = 0;
+    atomic_init(&init->stop, false);
+    init->threads_count = count;
+    size_t started = 0;
+    for (; started < count; ++started) {
+        scheduler_worker* worker = malloc(sizeof(scheduler_worker));
+        if (!worker) {
+            break;
+        }
+        worker->scheduler = init;
+        worker->id = started;
+        if (pthread_create(&init->threads[started], NULL, scheduler_thread, worker)) {
+            free(worker);
+            break;
+        }
+    }
+    if (started < count) {
+        // The deques of workers that never started would hold tasks forever.
+        for (size_t i = started + 1; i <= count; ++i) {
+            free(atomic_load_explicit(&init->deques[i].array, memory_order_relaxed));
+        }
+        init->threads_count = started;
+        scheduler_destroy(init);
+        return NULL;
+    }
+    return init;
+}
+/**
+ * @brief Run every submitted task, stop the worker threads and free a scheduler.
+ *
+ * @param self The scheduler to be freed. Must not be called from one of its tasks.
+ */
+void scheduler_destroy(scheduler_t* const self) {
+    if (!self) {
+        return;
+    }
+    scheduler_wait(self);
+    pthread_mutex_lock(&self->lock);
+    atomic_store_explicit(&self->stop, true, memory_order_relaxed);
+    pthread_cond_broadcast(&self->wake);
+    pthread_mutex_unlock(&self->lock);
+    for (size_t i = 0; i < self->threads_count; ++i) {
+        pthread_join(self->threads[i], NULL);
+    }
+    for (size_t i = 0; i <= self->threads_count; ++i) {
+        scheduler_array* array = atomic_load_explicit(&self->deques[i].array, memory_order_relaxed);
+        while (array) {
+            scheduler_array* const previous = array->previous;
+            free(array);
+            array = previous;
+        }
+    }
+    pthread_mutex_destroy(&self->caller);
+    pthread_mutex_destroy(&self->inject_lock);
+    pthread_mutex_destroy(&self->lock);
+    pthread_cond_destroy(&self->wake);
+    free(self->injected);
+    free(self->threads);
+    free(self->deques);
+    free(self);
+}
+/**
+ * @brief Returns how many threads run tasks in a scheduler, a waiting caller included.
+ *
+ * @param self Scheduler to retrieve size from.
+ *
+ * @return Return worker threads in self plus one.
+ */
+size_t scheduler_size(scheduler_t* const self) {
+    if (!self) {
+        return 0;
+    }
+    return self->threads_count + 1;
+}
+/////////////////
+// Operations //
+////////////////
+/**
+ * @brief Call body over consecutive pieces of [begin, end) in parallel and wait for all of them.
+ *
+ * Pieces are split in halves on demand, so idle threads steal the largest
+ * pieces left. Loops may nest: a body may call scheduler_parallel_for again.
+ *
+ * @param self      Scheduler that will run the loop.
+ * @param begin     First index of the range.
+ * @param end       One past the last index of the range.
+ * @param grain     Largest piece handed to a single body call. 0 picks one from the range and thread count.
+ * @param body      Function called on [begin, end) pieces, from any thread and in no particular order.
+ * @param context   Pointer handed unchanged to every body call.
+ */
+void scheduler_parallel_for(scheduler_t* const self, const size_t begin, const size_t end, const size_t grain, void (*body)(const size_t begin, const size_t end, void* const context), void* const context) {
+    if (!self || !body || begin >= end) {
+        return;
+    }
+    scheduler_loop loop = { .body = body, .context = context, .grain = grain };
+    if (!loop.grain) {
+        loop.grain = (end - begin) / (scheduler_size(self) * _LOOP_SPLITS_);
+        loop.grain = loop.grain ? loop.grain : 1;
+    }
+    atomic_init(&loop.remaining, end - begin);
+    scheduler_entry entry;
+    scheduler_deque* const own = scheduler_enter(self, &entry);
+    if (own) {
+        scheduler_loop_run(self, own, &loop, begin, end);
+    } else {
+        const scheduler_task root = { .function = NULL, .context = &loop, .begin = begin, .end = end };
+        if (!scheduler_push(self, &root)) {
+            body(begin, end, context);
+            return;
+        }
+    }
+    scheduler_help(self, own, &loop.remaining);
+    scheduler_leave(self, &entry);
+}
+/**
+ * @brief Queue a task on a scheduler. Submitted from one of its tasks, it lands on the worker's own deque.
+ *
+ * @param self      Scheduler that will run the task.
+ * @param function  Function to call once, from any thread.
+ * @param context   Pointer handed unchanged to function.
+ *
+ * @return Return true if the task was queued, false if no memory was left for it.
+ */
+bool scheduler_submit(scheduler_t* const self, void (*function)(void* const context), void* const context) {
+    if (!self || !function) {
+        return false;
+    }
+    const scheduler_task task = { .function = function, .context = context, .begin = 0, .end = 0 };
+    atomic_fetch_add_explicit(&self->pending, 1, memory_order_relaxed);
+    if (!scheduler_push(self, &task)) {
+        atomic_fetch_sub_explicit(&self->pending, 1, memory_order_relaxed);
+        return false;
+    }
+    return true;
+}
+/**
+ * @brief Run tasks from the calling thread until every submitted task is finished.
+ *
+ * @param self Scheduler to wait on. Must not be called from one of its tasks.
+ */
+void scheduler_wait(scheduler_t* const self) {
+    if (!self) {
+        return;
+    }
+    scheduler_entry entry;
+    scheduler_deque* const own = scheduler_enter(self, &entry);
+    scheduler_help(self, own, &self->pending);
+    scheduler_leave(self, &entry);
+}
@@ -0,0 +1,52 @@
+/*
+MIT License
+
+Copyright (c) 2018 Joseph Ojeda
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+ * Work-stealing task scheduler. Every worker thread owns a Chase-Lev
+ * deque: it pushes and pops tasks at the bottom while idle workers steal
+ * from the top of a randomly chosen victim. Tasks submitted from outside
+ * the scheduler go through a shared injection queue.
+ */
+typedef struct _internal_scheduler scheduler_t;
+
+///////////
+// Basic //
+///////////
+scheduler_t*    scheduler_init(const size_t threads_count);
+void            scheduler_destroy(scheduler_t* const self);
+size_t          scheduler_size(scheduler_t* const self);
+/////////////////
+// Operations //
+////////////////
+void            scheduler_parallel_for(scheduler_t* const self, const size_t begin, const size_t end, const size_t grain, void (*body)(const size_t begin, const size_t end, void* const context), void* const context);
+bool            scheduler_submit(scheduler_t* const self, void (*function)(void* const context), void* const context);
+void            scheduler_wait(scheduler_t* const self);
+
+#endif
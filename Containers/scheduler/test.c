@@ -0,0 +1,133 @@
+/*
+MIT License
+
+Copyright (c) 2018 Joseph Ojeda
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#define _POSIX_C_SOURCE 200809L // nanosleep
+
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "./src/scheduler.h"
+#include "../deque/src/deque.h"
+#include "../vector/src/vector.h"
+
+typedef struct square_job {
+    vector_t* vector;
+    atomic_long sum;
+} square_job;
+
+static void square(const size_t begin, const size_t end, void* const context) {
+    square_job* const job = context;
+    long sum = 0;
+    for (size_t i = begin; i < end; ++i) {
+        int* const element = vector_at(job->vector, i);
+        *element *= *element;
+        sum += *element;
+    }
+    atomic_fetch_add(&job->sum, sum);
+}
+
+static void negate(const size_t begin, const size_t end, void* const context) {
+    for (size_t i = begin; i < end; ++i) {
+        int* const element = deque_at(context, i);
+        *element = -*element;
+    }
+}
+
+static void count(void* const context) {
+    atomic_fetch_add((atomic_int*)context, 1);
+}
+
+static scheduler_t* scheduler;
+
+static void count_cells(const size_t begin, const size_t end, void* const context) {
+    atomic_fetch_add((atomic_long*)context, (long)(end - begin));
+}
+
+static void count_rows(const size_t begin, const size_t end, void* const context) {
+    for (size_t i = begin; i < end; ++i) {
+        scheduler_parallel_for(scheduler, 0, 100, 8, count_cells, context);
+    }
+}
+
+static void spawn(void* const context) {
+    for (int i = 0; i < 10; ++i) {
+        scheduler_submit(scheduler, count, context);
+    }
+}
+
+int main(void) {
+    scheduler = scheduler_init(4);
+    printf("scheduler_size(scheduler) = %ld\n", scheduler_size(scheduler));
+
+    square_job job = { .vector = vector_init(sizeof(int), 1000) };
+    atomic_init(&job.sum, 0);
+    for (int i = 0; i < 1000; ++i) {
+        vector_push_back(job.vector, &i, sizeof(int));
+    }
+    scheduler_parallel_for(scheduler, 0, vector_size(job.vector), 0, square, &job);
+    printf("\nscheduler_parallel_for(scheduler, 0, 1000, 0, square, &job)\n");
+    printf("job.sum = %ld\n", atomic_load(&job.sum));
+    printf("vector_at(vector, 999) = %d\n", *(int*)vector_at(job.vector, 999));
+
+    deque_t* deque = deque_init(sizeof(int));
+    for (int i = 0; i < 1000; ++i) {
+        deque_push_back(deque, &i, sizeof(int));
+    }
+    scheduler_parallel_for(scheduler, 0, deque_size(deque), 64, negate, deque);
+    printf("\nscheduler_parallel_for(scheduler, 0, 1000, 64, negate, deque)\n");
+    printf("deque_back(deque) = %d\n", *(int*)deque_back(deque));
+
+    atomic_int calls;
+    atomic_init(&calls, 0);
+    for (int i = 0; i < 100; ++i) {
+        scheduler_submit(scheduler, count, &calls);
+    }
+    scheduler_wait(scheduler);
+    printf("\nscheduler_submit(scheduler, count, &calls) x 100\n");
+    printf("calls = %d\n", atomic_load(&calls));
+
+    // Idle long enough for the workers to go to sleep, the next loop wakes them.
+    nanosleep(&(struct timespec){ .tv_sec = 0, .tv_nsec = 20000000 }, NULL);
+    atomic_long cells;
+    atomic_init(&cells, 0);
+    scheduler_parallel_for(scheduler, 0, 100, 1, count_rows, &cells);
+    printf("\nscheduler_parallel_for(scheduler, 0, 100, 1, count_rows, &cells), nested 100 wide\n");
+    printf("cells = %ld\n", atomic_load(&cells));
+
+    atomic_init(&calls, 0);
+    for (int i = 0; i < 10; ++i) {
+        scheduler_submit(scheduler, spawn, &calls);
+    }
+    scheduler_wait(scheduler);
+    printf("\nscheduler_submit(scheduler, spawn, &calls) x 10, each submitting count x 10\n");
+    printf("calls = %d\n", atomic_load(&calls));
+
+    vector_destroy(job.vector);
+    deque_destroy(deque);
+    scheduler_destroy(scheduler);
+
+    return EXIT_SUCCESS;
+}
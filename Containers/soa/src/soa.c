@@ -0,0 +1,407 @@
+/*
+MIT License
+
+Copyright (c) 2018 Joseph Ojeda
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <stdlib.h> // malloc, free
+#include <string.h> // memcpy
+
+#include "./soa.h"
+
+struct _internal_soa {
+    size_t fields_count;
+    size_t record_size;
+    vector_t** columns;
+    size_t* offsets;            // Offset of each field inside a packed record.
+};
+/*
+ * Check if a soa and it's columns are not null.
+ */
+static bool soa_status(soa_t* const self) {
+    return self && self->columns;
+}
+/*
+ * Branch-free range filter over one column: every index is written and the
+ * output cursor only advances on a match, so the loop has no unpredictable
+ * branches and the compares can be vectorized.
+ */
+#define _SOA_FILTER_RANGE_(name, type)                                                              \
+    static size_t filter_range_##name(const type* const values, const size_t size, const void* const min, const void* const max, size_t* const indices) { \
+        type low;                                                                                   \
+        type high;                                                                                  \
+        memcpy(&low, min, sizeof(type));                                                            \
+        memcpy(&high, max, sizeof(type));                                                           \
+        size_t count = 0;                                                                           \
+        for (size_t i = 0; i < size; ++i) {                                                         \
+            indices[count] = i;                                                                     \
+            count += (values[i] >= low) & (values[i] <= high);                                      \
+        }                                                                                           \
+        return count;                                                                               \
+    }
+
+_SOA_FILTER_RANGE_(int32, int32_t)
+_SOA_FILTER_RANGE_(uint32, uint32_t)
+_SOA_FILTER_RANGE_(int64, int64_t)
+_SOA_FILTER_RANGE_(uint64, uint64_t)
+_SOA_FILTER_RANGE_(float, float)
+_SOA_FILTER_RANGE_(double, double)
+///////////
+// Basic //
+///////////
+/**
+ * @brief Initialize a new struct-of-arrays container.
+ *
+ * @param fields_sizes      Size in bytes of every field of a record, in order.
+ * @param fields_count      How many fields a record has.
+ * @param elements_count    How many records each column will have room for at it's creation.
+ *
+ * @return A new struct-of-arrays container.
+ */
+soa_t* soa_init(const size_t* const fields_sizes, const size_t fields_count, const size_t elements_count) {
+    if (!fields_sizes || !fields_count) {
+        return NULL;
+    }
+    soa_t* init = malloc(sizeof(soa_t));
+    if (!init) {
+        return NULL;
+    }
+    init->fields_count = fields_count;
+    init->record_size = 0;
+    init->columns = calloc(fields_count, sizeof(vector_t*));
+    init->offsets = malloc(fields_count * sizeof(size_t));
+    if (!init->columns || !init->offsets) {
+        free(init->columns);
+        free(init->offsets);
+        free(init);
+        return NULL;
+    }
+    for (size_t i = 0; i < fields_count; ++i) {
+        init->offsets[i] = init->record_size;
+        init->record_size += fields_sizes[i];
+        init->columns[i] = vector_init(fields_sizes[i], elements_count);
+        if (!init->columns[i]) {
+            soa_destroy(init);
+            return NULL;
+        }
+    }
+    return init;
+}
+/**
+ * @brief Free the memory of every column plus container itself.
+ *
+ * @param self The struct-of-arrays container to be freed.
+ */
+void soa_destroy(soa_t* const self) {
+    if (!self) {
+        return;
+    }
+    for (size_t i = 0; i < self->fields_count; ++i) {
+        vector_destroy(self->columns[i]);
+    }
+    free(self->columns);
+    free(self->offsets);
+    free(self);
+}
+////////////
+// Access //
+////////////
+/**
+ * @brief Returns one field of one record.
+ *
+ * @param self  Struct-of-arrays container to get the field from.
+ * @param index Position of the record. Start point is 0.
+ * @param field Position of the field in the schema.
+ *
+ * @return Return a pointer to the field value, or NULL if index or field is out of range.
+ */
+void* soa_at(soa_t* const self, const size_t index, const size_t field) {
+    if (!soa_status(self) || field >= self->fields_count || index >= soa_size(self)) {
+        return NULL;
+    }
+    return vector_at(self->columns[field], index);
+}
+/**
+ * @brief Returns the contiguous column holding one field of every record.
+ *
+ * @param self  Struct-of-arrays container to get the column from.
+ * @param field Position of the field in the schema.
+ *
+ * @return Return the first value of the column, valid until the container grows.
+ */
+void* soa_column(soa_t* const self, const size_t field) {
+    if (!soa_status(self) || field >= self->fields_count) {
+        return NULL;
+    }
+    return vector_data(self->columns[field]);
+}
+/**
+ * @brief Copy a whole record out of a struct-of-arrays container.
+ *
+ * @param self      Struct-of-arrays container to read from.
+ * @param index     Position of the record.
+ * @param record    Receives the fields packed back to back, soa_record_size bytes.
+ */
+void soa_get(soa_t* const self, const size_t index, void* const record) {
+    if (!soa_status(self) || !record || index >= soa_size(self)) {
+        return;
+    }
+    for (size_t i = 0; i < self->fields_count; ++i) {
+        memcpy((uint8_t*)record + self->offsets[i], vector_get(self->columns[i], index), vector_elements_size(self->columns[i]));
+    }
+}
+//////////////
+// Capacity //
+//////////////
+/**
+ * @brief Returns the size in bytes of one field.
+ *
+ * @param self  Struct-of-arrays container to check.
+ * @param field Position of the field in the schema.
+ *
+ * @return Return the field size, or 0 if field is out of range.
+ */
+size_t soa_field_size(soa_t* const self, const size_t field) {
+    if (!soa_status(self) || field >= self->fields_count) {
+        return 0;
+    }
+    return vector_elements_size(self->columns[field]);
+}
+/**
+ * @brief Returns how many fields a record has.
+ *
+ * @param self Struct-of-arrays container to check.
+ *
+ * @return Return the fields count of self.
+ */
+size_t soa_fields_count(soa_t* const self) {
+    return self ? self->fields_count : 0;
+}
+/**
+ * @brief Returns if a struct-of-arrays container has any records at all.
+ *
+ * @param self Struct-of-arrays container to check size from.
+ *
+ * @return Return true if self has 0 size.
+ */
+bool soa_is_empty(soa_t* const self) {
+    return soa_size(self) == 0;
+}
+/**
+ * @brief Returns the size of a packed record.
+ *
+ * @param self Struct-of-arrays container to check.
+ *
+ * @return Return the sum of every field size.
+ */
+size_t soa_record_size(soa_t* const self) {
+    return self ? self->record_size : 0;
+}
+/**
+ * @brief Make room for size records in every column.
+ *
+ * @param self Struct-of-arrays container to set capacity at.
+ * @param size Records every column must be able to hold.
+ */
+void soa_reserve(soa_t* const self, const size_t size) {
+    if (!soa_status(self)) {
+        return;
+    }
+    for (size_t i = 0; i < self->fields_count; ++i) {
+        vector_reserve(self->columns[i], size);
+    }
+}
+/**
+ * @brief Returns the current records count of a struct-of-arrays container.
+ *
+ * @param self Struct-of-arrays container to retrieve size from.
+ *
+ * @return Return the current size of self.
+ */
+size_t soa_size(soa_t* const self) {
+    if (!soa_status(self)) {
+        return 0;
+    }
+    return vector_size(self->columns[0]);
+}
+////////////////
+// Operations //
+////////////////
+/**
+ * @brief Remove all records from a struct-of-arrays container.
+ *
+ * @param self Struct-of-arrays container whose records are going to be removed.
+ */
+void soa_clear(soa_t* const self) {
+    if (!soa_status(self)) {
+        return;
+    }
+    for (size_t i = 0; i < self->fields_count; ++i) {
+        vector_clear(self->columns[i]);
+    }
+}
+/**
+ * @brief Remove a records range from a struct-of-arrays container.
+ *
+ * @param self  Struct-of-arrays container whose records will be erased.
+ * @param start Position of the first record to erase.
+ * @param end   Position of the last record to erase, inclusive.
+ */
+void soa_erase(soa_t* const self, const size_t start, const size_t end) {
+    if (!soa_status(self)) {
+        return;
+    }
+    for (size_t i = 0; i < self->fields_count; ++i) {
+        vector_erase(self->columns[i], start, end);
+    }
+}
+/**
+ * @brief Remove the last record of a struct-of-arrays container.
+ *
+ * @param self Struct-of-arrays container whose last record will be removed.
+ */
+void soa_pop_back(soa_t* const self) {
+    if (!soa_status(self)) {
+        return;
+    }
+    for (size_t i = 0; i < self->fields_count; ++i) {
+        vector_pop_back(self->columns[i]);
+    }
+}
+/**
+ * @brief Push a record at struct-of-arrays container end, one field per column.
+ *
+ * @param self          Struct-of-arrays container that will hold the record.
+ * @param record        Fields packed back to back in schema order.
+ * @param record_size   Size of record, must match soa_record_size.
+ */
+void soa_push_back(soa_t* const self, const void* const record, const size_t record_size) {
+    if (!soa_status(self) || !record || record_size != self->record_size) {
+        return;
+    }
+    const size_t size = soa_size(self);
+    for (size_t i = 0; i < self->fields_count; ++i) {
+        vector_t* const column = self->columns[i];
+        vector_push_back(column, (const uint8_t*)record + self->offsets[i], vector_elements_size(column));
+        if (vector_size(column) == size) {
+            // Keep every column the same length if one of them could not grow.
+            for (size_t j = 0; j < i; ++j) {
+                vector_pop_back(self->columns[j]);
+            }
+            return;
+        }
+    }
+}
+/**
+ * @brief Overwrite a whole record of a struct-of-arrays container.
+ *
+ * @param self      Struct-of-arrays container to write to.
+ * @param index     Position of the record.
+ * @param record    Fields packed back to back in schema order.
+ */
+void soa_set(soa_t* const self, const size_t index, const void* const record) {
+    if (!soa_status(self) || !record || index >= soa_size(self)) {
+        return;
+    }
+    for (size_t i = 0; i < self->fields_count; ++i) {
+        memcpy(vector_at(self->columns[i], index), (const uint8_t*)record + self->offsets[i], vector_elements_size(self->columns[i]));
+    }
+}
+//////////////////
+// Column scans //
+//////////////////
+/**
+ * @brief Collect the indices of records whose field matches a predicate.
+ *
+ * @param self      Struct-of-arrays container to scan.
+ * @param field     Position of the field to test.
+ * @param predicate Function returning true for matching values.
+ * @param context   Pointer handed unchanged to every predicate call.
+ * @param indices   Receives matching record indices in order, must hold soa_size entries.
+ *
+ * @return Return how many records matched.
+ */
+size_t soa_filter(soa_t* const self, const size_t field, bool (*predicate)(const void* const value, void* const context), void* const context, size_t* const indices) {
+    if (!soa_status(self) || field >= self->fields_count || !predicate || !indices) {
+        return 0;
+    }
+    const uint8_t* const values = vector_cdata(self->columns[field]);
+    const size_t field_size = vector_elements_size(self->columns[field]);
+    const size_t size = soa_size(self);
+    size_t count = 0;
+    for (size_t i = 0; i < size; ++i) {
+        if (predicate(values + i * field_size, context)) {
+            indices[count++] = i;
+        }
+    }
+    return count;
+}
+/**
+ * @brief Collect the indices of records whose numeric field lies in [min, max].
+ *
+ * @param self      Struct-of-arrays container to scan.
+ * @param field     Position of the field to test, its size must match key.
+ * @param key       Numeric type of the field.
+ * @param min       Lowest accepted value, of type key.
+ * @param max       Highest accepted value, of type key.
+ * @param indices   Receives matching record indices in order, must hold soa_size entries.
+ *
+ * @return Return how many records matched.
+ */
+size_t soa_filter_range(soa_t* const self, const size_t field, const vector_key key, const void* const min, const void* const max, size_t* const indices) {
+    if (!soa_status(self) || field >= self->fields_count || !min || !max || !indices || soa_is_empty(self)) {
+        return 0;
+    }
+    const void* const values = vector_cdata(self->columns[field]);
+    const size_t field_size = vector_elements_size(self->columns[field]);
+    const size_t size = soa_size(self);
+    switch (key) {
+        case VECTOR_KEY_INT32:  return field_size == 4 ? filter_range_int32(values, size, min, max, indices) : 0;
+        case VECTOR_KEY_UINT32: return field_size == 4 ? filter_range_uint32(values, size, min, max, indices) : 0;
+        case VECTOR_KEY_FLOAT:  return field_size == 4 ? filter_range_float(values, size, min, max, indices) : 0;
+        case VECTOR_KEY_INT64:  return field_size == 8 ? filter_range_int64(values, size, min, max, indices) : 0;
+        case VECTOR_KEY_UINT64: return field_size == 8 ? filter_range_uint64(values, size, min, max, indices) : 0;
+        case VECTOR_KEY_DOUBLE: return field_size == 8 ? filter_range_double(values, size, min, max, indices) : 0;
+    }
+    return 0;
+}
+/**
+ * @brief Copy one field of selected records into a packed array.
+ *
+ * @param self          Struct-of-arrays container to read from.
+ * @param field         Position of the field to copy.
+ * @param indices       Record indices to copy, as produced by the filters.
+ * @param indices_count How many indices there are.
+ * @param values        Receives indices_count field values back to back.
+ */
+void soa_gather(soa_t* const self, const size_t field, const size_t* const indices, const size_t indices_count, void* const values) {
+    if (!soa_status(self) || field >= self->fields_count || !indices || !values) {
+        return;
+    }
+    const uint8_t* const column = vector_cdata(self->columns[field]);
+    const size_t field_size = vector_elements_size(self->columns[field]);
+    const size_t size = soa_size(self);
+    for (size_t i = 0; i < indices_count; ++i) {
+        if (indices[i] < size) {
+            memcpy((uint8_t*)values + i * field_size, column + indices[i] * field_size, field_size);
+        }
+    }
+}
@@ -0,0 +1,75 @@
+/*
+MIT License
+
+Copyright (c) 2018 Joseph Ojeda
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef SOA_H
+#define SOA_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "../../vector/src/vector_sort.h"
+
+/*
+ * Struct-of-arrays container. A record is described by the sizes of its
+ * fields; each field is stored in its own vector_t column, so a scan over
+ * one field only touches that field's memory. Records passed in and out
+ * are the fields packed back to back in schema order.
+ */
+typedef struct _internal_soa soa_t;
+///////////
+// Basic //
+///////////
+soa_t*      soa_init(const size_t* const fields_sizes, const size_t fields_count, const size_t elements_count);
+void        soa_destroy(soa_t* const self);
+////////////
+// Access //
+////////////
+void*       soa_at(soa_t* const self, const size_t index, const size_t field);
+void*       soa_column(soa_t* const self, const size_t field);
+void        soa_get(soa_t* const self, const size_t index, void* const record);
+//////////////
+// Capacity //
+//////////////
+size_t      soa_field_size(soa_t* const self, const size_t field);
+size_t      soa_fields_count(soa_t* const self);
+bool        soa_is_empty(soa_t* const self);
+size_t      soa_record_size(soa_t* const self);
+void        soa_reserve(soa_t* const self, const size_t size);
+size_t      soa_size(soa_t* const self);
+/////////////////
+// Operations //
+////////////////
+void        soa_clear(soa_t* const self);
+void        soa_erase(soa_t* const self, const size_t start, const size_t end);
+void        soa_pop_back(soa_t* const self);
+void        soa_push_back(soa_t* const self, const void* const record, const size_t record_size);
+void        soa_set(soa_t* const self, const size_t index, const void* const record);
+//////////////////
+// Column scans //
+//////////////////
+size_t      soa_filter(soa_t* const self, const size_t field, bool (*predicate)(const void* const value, void* const context), void* const context, size_t* const indices);
+size_t      soa_filter_range(soa_t* const self, const size_t field, const vector_key key, const void* const min, const void* const max, size_t* const indices);
+void        soa_gather(soa_t* const self, const size_t field, const size_t* const indices, const size_t indices_count, void* const values);
+
+#endif
@@ -0,0 +1,70 @@
+/*
+MIT License
+
+Copyright (c) 2018 Joseph Ojeda
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "./src/soa.h"
+
+int main(void) {
+    // Schema: uint32_t id, double value, int32_t code.
+    const size_t fields[] = { sizeof(uint32_t), sizeof(double), sizeof(int32_t) };
+    soa_t* soa1 = soa_init(fields, 3, 0);
+    printf("soa1.size = %ld\n", soa_size(soa1));
+    printf("soa1.record_size = %ld\n", soa_record_size(soa1));
+    uint8_t record[sizeof(uint32_t) + sizeof(double) + sizeof(int32_t)];
+    for (uint32_t i = 0; i < 100; ++i) {
+        const double value = i * 0.5;
+        const int32_t code = (int32_t)(i % 7) - 3;
+        memcpy(record, &i, sizeof(i));
+        memcpy(record + sizeof(i), &value, sizeof(value));
+        memcpy(record + sizeof(i) + sizeof(value), &code, sizeof(code));
+        soa_push_back(soa1, record, sizeof(record));
+    }
+    printf("\nsoa1.size = %ld\n", soa_size(soa1));
+    printf("soa1.at(10).value = %f\n", *(double*)(soa_at(soa1, 10, 1)));
+    printf("soa1.column(2)[10] = %d\n", ((int32_t*)soa_column(soa1, 2))[10]);
+
+    size_t* indices = malloc(soa_size(soa1) * sizeof(size_t));
+    const int32_t low = 2;
+    const int32_t high = 3;
+    const size_t matches = soa_filter_range(soa1, 2, VECTOR_KEY_INT32, &low, &high, indices);
+    printf("\nsoa_filter_range(code in [2, 3]) = %ld\n", matches);
+    double* values = malloc(matches * sizeof(double));
+    soa_gather(soa1, 1, indices, matches, values);
+    printf("values[0] = %f\n", values[0]);
+    printf("values[%ld] = %f\n", matches - 1, values[matches - 1]);
+
+    soa_erase(soa1, 0, 49);
+    soa_get(soa1, 0, record);
+    printf("\nsoa1.size = %ld\n", soa_size(soa1));
+    printf("soa1.at(0).id = %u\n", *(uint32_t*)record);
+
+    free(values);
+    free(indices);
+    soa_destroy(soa1);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,115 @@
+/*
+MIT License
+
+Copyright (c) 2018 Joseph Ojeda
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#define _POSIX_C_SOURCE 200809L // clock_gettime, CLOCK_MONOTONIC
+
+#include <pthread.h> // pthread_create, pthread_mutex_t
+#include <stdio.h>   // printf
+#include <stdlib.h>  // EXIT_SUCCESS
+#include <time.h>    // clock_gettime
+
+#include "./src/stack.h"
+#include "./src/stack_concurrent.h"
+
+#define BENCH_OPERATIONS 200000 // Push and pop pairs per thread.
+#define BENCH_ROUNDS 5          // Each timing is the best of this many runs.
+#define BENCH_MAX_THREADS 8
+
+/*
+ * The stack shared the way it was before stack_concurrent: one STACK_VALUES
+ * stack_t behind a mutex.
+ */
+typedef struct locked_stack {
+    pthread_mutex_t lock;
+    stack_t* stack;
+} locked_stack;
+
+static void* locked_work(void* const argument) {
+    locked_stack* const self = argument;
+    for (int i = 0; i < BENCH_OPERATIONS; ++i) {
+        int value = i;
+        pthread_mutex_lock(&self->lock);
+        stack_push(self->stack, &value, sizeof(int));
+        pthread_mutex_unlock(&self->lock);
+        pthread_mutex_lock(&self->lock);
+        stack_pop_n(self->stack, &value, 1);
+        pthread_mutex_unlock(&self->lock);
+    }
+    return NULL;
+}
+
+static void* concurrent_work(void* const argument) {
+    stack_concurrent_t* const self = argument;
+    for (int i = 0; i < BENCH_OPERATIONS; ++i) {
+        int value = i;
+        stack_concurrent_push(self, &value, sizeof(int));
+        stack_concurrent_pop(self, &value);
+    }
+    return NULL;
+}
+
+static double elapsed_ms(const struct timespec* const start) {
+    struct timespec end;
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    return (end.tv_sec - start->tv_sec) * 1e3 + (end.tv_nsec - start->tv_nsec) / 1e6;
+}
+/*
+ * Best time over BENCH_ROUNDS of threads running function on argument at once.
+ */
+static double run(const int threads, void* (*function)(void*), void* const argument) {
+    pthread_t workers[BENCH_MAX_THREADS];
+    double best = 0;
+    for (size_t round = 0; round < BENCH_ROUNDS; ++round) {
+        struct timespec start;
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        for (int i = 0; i < threads; ++i) {
+            pthread_create(&workers[i], NULL, function, argument);
+        }
+        for (int i = 0; i < threads; ++i) {
+            pthread_join(workers[i], NULL);
+        }
+        const double ms = elapsed_ms(&start);
+        best = round && best < ms ? best : ms;
+    }
+    return best;
+}
+
+int main(void) {
+    printf("Shared stack, %d push and pop pairs per thread:\n", BENCH_OPERATIONS);
+    locked_stack locked = { PTHREAD_MUTEX_INITIALIZER, stack_init_flags(sizeof(int), STACK_VALUES) };
+    stack_concurrent_t* concurrent = stack_concurrent_init(sizeof(int));
+    if (!locked.stack || !concurrent) {
+        stack_destroy(locked.stack);
+        stack_concurrent_destroy(concurrent);
+        return EXIT_FAILURE;
+    }
+    for (int threads = 1; threads <= BENCH_MAX_THREADS; threads *= 2) {
+        const double mutex = run(threads, locked_work, &locked);
+        const double lock_free = run(threads, concurrent_work, concurrent);
+        printf("\t%d threads: mutex stack_t %8.2f ms | stack_concurrent %8.2f ms\n", threads, mutex, lock_free);
+    }
+    stack_destroy(locked.stack);
+    stack_concurrent_destroy(concurrent);
+    return EXIT_SUCCESS;
+}
@@ -22,26 +22,256 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.
 */
 
-#include <stdlib.h>  // malloc, NULL
+#include <stddef.h>  // max_align_t
+#include <stdlib.h>  // malloc, realloc, NULL
+#include <string.h>  // memcpy, memset
 
 #include "./stack.h"
 
+#define _MIN_CAPACITY_ 8
+#define _MIN_SLAB_NODES_ 16
+#define _MAX_SLAB_NODES_ 4096
+
 typedef struct stack_node {
     void* element;
     struct stack_node* next;
+    max_align_t value[];    // STACK_VALUES copy of the element, element points here.
 } stack_node;
 
+/*
+ * Block of nodes of a linked stack. Nodes are carved from slabs in order,
+ * popped ones are recycled through a free list and all of them go back at
+ * once when the stack empties. Slabs carved from lead the pool, ahead of
+ * the untouched ones.
+ */
+typedef struct stack_slab {
+    struct stack_slab* next;
+    size_t count;
+    size_t carved;              // Nodes carved so far.
+    max_align_t nodes[];
+} stack_slab;
+
+/*
+ * Linked stacks chain nodes from top. STACK_ARRAY stacks keep the elements
+ * bottom to top in slots, the top being the last one. A slot holds the
+ * element pointer, or the element itself with STACK_VALUES.
+ */
 struct _internal_stack {
     size_t size;
     size_t elements_size;
     stack_node* top;
+    stack_node* bottom;
+    uint32_t flags;
+    uint8_t* slots;
+    size_t capacity;
+    stack_slab* slabs;
+    stack_slab* slabs_tail;
+    stack_slab* used_tail;      // Last slab carved from, NULL if none.
+    stack_slab* current;        // Slab nodes are carved from, NULL until the first carve.
+    stack_node* free_nodes;     // Popped nodes, chained through next.
+    stack_node* free_tail;
+    size_t pooled;              // Nodes held by all slabs.
+    size_t pool_limit;          // Pooled nodes kept once the stack empties.
 };
 
 /*
  * Check if a stack and it's elements are not null.
  */
 bool stack_status(stack_t* const self) {
-    return self && self->top;
+    return self && self->size;
+}
+static size_t stack_slot_size(stack_t* const self) {
+    return self->flags & STACK_VALUES ? self->elements_size : sizeof(void*);
+}
+
+static void* stack_slot(stack_t* const self, const size_t index) {
+    if (self->flags & STACK_VALUES) {
+        return self->slots + index * self->elements_size;
+    }
+    return ((void**)self->slots)[index];
+}
+static void stack_slot_set(stack_t* const self, const size_t index, void* const element) {
+    if (self->flags & STACK_VALUES) {
+        memcpy(self->slots + index * self->elements_size, element, self->elements_size);
+    }
+    else {
+        ((void**)self->slots)[index] = element;
+    }
+}
+/*
+ * Check if a pointer stack holds a pushed NULL, which a STACK_VALUES stack cannot take.
+ */
+static bool stack_holds_null(stack_t* const self) {
+    if (self->flags & STACK_VALUES) {
+        return false;
+    }
+    if (self->flags & STACK_ARRAY) {
+        for (size_t i = 0; i < self->size; ++i) {
+            if (!((void**)self->slots)[i]) {
+                return true;
+            }
+        }
+        return false;
+    }
+    for (stack_node* node = self->top; node; node = node->next) {
+        if (!node->element) {
+            return true;
+        }
+    }
+    return false;
+}
+/*
+ * Copy an element out of the stack, pushed NULL pointers read as zeros.
+ */
+static void stack_element_read(stack_t* const self, const void* const element, void* const out) {
+    if (element) {
+        memcpy(out, element, self->elements_size);
+    }
+    else {
+        memset(out, 0, self->elements_size);
+    }
+}
+/*
+ * Node stride inside a slab, keeping every node max_align_t aligned.
+ */
+static size_t stack_node_size(stack_t* const self) {
+    const size_t bytes = sizeof(stack_node) + (self->flags & STACK_VALUES ? self->elements_size : 0);
+    return (bytes + _Alignof(max_align_t) - 1) / _Alignof(max_align_t) * _Alignof(max_align_t);
+}
+/*
+ * Append a slab of count nodes to the pool. A count whose byte size
+ * overflows is refused, leaving the pool unchanged.
+ */
+static stack_slab* stack_slab_new(stack_t* const self, const size_t count) {
+    if (count > (SIZE_MAX - sizeof(stack_slab)) / stack_node_size(self)) {
+        return NULL;
+    }
+    stack_slab* slab = malloc(sizeof(stack_slab) + count * stack_node_size(self));
+    if (!slab) {
+        return NULL;
+    }
+    slab->next = NULL;
+    slab->count = count;
+    slab->carved = 0;
+    if (self->slabs_tail) {
+        self->slabs_tail->next = slab;
+    }
+    else {
+        self->slabs = slab;
+    }
+    self->slabs_tail = slab;
+    self->pooled += count;
+    return slab;
+}
+/*
+ * Take every node back into the pool, then free the slabs past the first
+ * keep nodes, if the pool holds more than that. Only valid once no node
+ * is in use anymore.
+ */
+static void stack_pool_reset(stack_t* const self, const size_t keep) {
+    self->current = NULL;
+    self->free_nodes = NULL;
+    self->free_tail = NULL;
+    if (self->used_tail) {
+        // Only the leading slabs were carved from, the rest are untouched.
+        for (stack_slab* slab = self->slabs; slab != self->used_tail->next; slab = slab->next) {
+            slab->carved = 0;
+        }
+        self->used_tail = NULL;
+    }
+    if (self->pooled <= keep) {
+        return;
+    }
+    size_t kept = 0;
+    stack_slab* last = NULL;
+    stack_slab** link = &self->slabs;
+    while (*link && (*link)->count <= keep - kept) {
+        kept += (*link)->count;
+        last = *link;
+        link = &(*link)->next;
+    }
+    stack_slab* slab = *link;
+    *link = NULL;
+    while (slab) {
+        stack_slab* next = slab->next;
+        free(slab);
+        slab = next;
+    }
+    self->slabs_tail = last;
+    self->pooled = kept;
+}
+/*
+ * Allocate a node for element, holding a copy of it with STACK_VALUES.
+ * Recycled nodes come first, then nodes carved from the pool, which grows
+ * by slabs as large as everything pooled so far.
+ */
+static stack_node* stack_node_new(stack_t* const self, void* const element) {
+    stack_node* node = self->free_nodes;
+    if (node) {
+        self->free_nodes = node->next;
+        if (!self->free_nodes) {
+            self->free_tail = NULL;
+        }
+    }
+    else {
+        if (!self->current || self->current->carved == self->current->count) {
+            stack_slab* next = self->current ? self->current->next : self->slabs;
+            // Slabs spliced from another stack may already be carved from.
+            while (next && next->carved == next->count) {
+                next = next->next;
+            }
+            if (!next) {
+                const size_t count = self->pooled < _MIN_SLAB_NODES_ ? _MIN_SLAB_NODES_ : self->pooled < _MAX_SLAB_NODES_ ? self->pooled : _MAX_SLAB_NODES_;
+                next = stack_slab_new(self, count);
+                if (!next) {
+                    return NULL;
+                }
+            }
+            self->current = next;
+        }
+        if (!self->current->carved) {
+            self->used_tail = self->current;
+        }
+        node = (stack_node*)((uint8_t*)self->current->nodes + self->current->carved++ * stack_node_size(self));
+    }
+    node->element = element;
+    if (self->flags & STACK_VALUES) {
+        node->element = memcpy(node->value, element, self->elements_size);
+    }
+    return node;
+}
+/*
+ * Resize the slots of a STACK_ARRAY stack to hold capacity elements. A
+ * capacity whose byte size overflows is refused, leaving the stack unchanged.
+ */
+static bool stack_grow(stack_t* const self, const size_t capacity) {
+    if (capacity > SIZE_MAX / stack_slot_size(self)) {
+        return false;
+    }
+    uint8_t* temp = realloc(self->slots, capacity * stack_slot_size(self));
+    if (!temp) {
+        return false;
+    }
+    self->slots = temp;
+    self->capacity = capacity;
+    return true;
+}
+/*
+ * Make sure a STACK_ARRAY stack fits count more elements, growing geometrically.
+ * Linked stacks always succeed, their pool grows by slabs as nodes are needed.
+ */
+static bool stack_make_room(stack_t* const self, const size_t count) {
+    if (!(self->flags & STACK_ARRAY) || count <= self->capacity - self->size) {
+        return true;
+    }
+    if (count > SIZE_MAX - self->size) {
+        return false;
+    }
+    size_t capacity = self->capacity < _MIN_CAPACITY_ ? _MIN_CAPACITY_ : self->capacity <= SIZE_MAX / 2 ? self->capacity * 2 : SIZE_MAX;
+    if (capacity - self->size < count) {
+        capacity = self->size + count;
+    }
+    return stack_grow(self, capacity);
 }
 ///////////
 // Basic //
@@ -54,7 +284,19 @@ bool stack_status(stack_t* const self) {
  * @return A new stack container.
  */
 stack_t* stack_init(const size_t elements_size) {
-    if (!elements_size) {
+    return stack_init_flags(elements_size, STACK_DEFAULT);
+}
+/**
+ * @brief Initialize a new stack container with storage options.
+ *
+ * @param elements_size What kind of variables is going to hold the stack container.
+ * @param flags         STACK_DEFAULT for linked nodes or STACK_ARRAY for contiguous storage,
+ *                      plus STACK_VALUES to store copies of the elements instead of pointers.
+ *
+ * @return A new stack container.
+ */
+stack_t* stack_init_flags(const size_t elements_size, const uint32_t flags) {
+    if (!elements_size || flags & ~(STACK_ARRAY | STACK_VALUES)) {
         return NULL;
     }
     stack_t* init = malloc(sizeof(stack_t));
@@ -64,6 +306,18 @@ stack_t* stack_init(const size_t elements_size) {
     init->size = 0;
     init->elements_size = elements_size;
     init->top = NULL;
+    init->bottom = NULL;
+    init->flags = flags;
+    init->slots = NULL;
+    init->capacity = 0;
+    init->slabs = NULL;
+    init->slabs_tail = NULL;
+    init->used_tail = NULL;
+    init->current = NULL;
+    init->free_nodes = NULL;
+    init->free_tail = NULL;
+    init->pooled = 0;
+    init->pool_limit = SIZE_MAX;
     return init;
 }
 /**
@@ -75,14 +329,10 @@ void stack_destroy(stack_t* const self) {
     if (!self) {
         return;
     }
-    if (!self->size) {
-        free(self);
-    }
-    else if (self->size) {
-        stack_clear(self);
-        free(self->top);
-        free(self);
-    }
+    // Nodes live in the pool slabs, so they all go back at once.
+    stack_pool_reset(self, 0);
+    free(self->slots);
+    free(self);
 }
 ////////////
 // Access //
@@ -95,24 +345,82 @@ void stack_destroy(stack_t* const self) {
  * @return Return true if self stack node is null.
  */
 bool stack_is_empty(stack_t* const self) {
-    return self ? self->top == NULL : true;
+    return self ? self->size == 0 : true;
 }
 /**
  * @brief Return the element at the top of a stack container.
  * 
  * @param self Stack container to retrieve element from.
  * 
- * @return Return the element at the top of self.
+ * @return Return the element at the top of self. With STACK_VALUES it lives inside self
+ *         and stays valid until that element is popped. A STACK_ARRAY stack also moves
+ *         its elements when it grows, so a push may invalidate it too.
  */
 void* stack_top(stack_t* const self) {
     if (!stack_status(self)) {
         return NULL;
     }
+    if (self->flags & STACK_ARRAY) {
+        return stack_slot(self, self->size - 1);
+    }
     return self->top->element;
 }
 //////////////
 // Capacity //
 //////////////
+/**
+ * @brief Returns how many elements a stack container holds before it allocates again.
+ *
+ * @param self Stack container to retrieve capacity from.
+ *
+ * @return Return the capacity of a STACK_ARRAY stack, the nodes pooled by a linked one.
+ */
+size_t stack_capacity(stack_t* const self) {
+    if (!self) {
+        return 0;
+    }
+    return self->flags & STACK_ARRAY ? self->capacity : self->pooled;
+}
+/**
+ * @brief Make room for at least size elements in a stack container.
+ *
+ * Grows the slots of a STACK_ARRAY stack, or the node pool of a linked one.
+ *
+ * @param self Stack container to set capacity at.
+ * @param size New capacity to be set, unless it's lesser than the current one.
+ *
+ * @return Return false if the memory could not be allocated, leaving the capacity unchanged.
+ */
+bool stack_reserve(stack_t* const self, const size_t size) {
+    if (!self) {
+        return false;
+    }
+    if (size <= stack_capacity(self)) {
+        return true;
+    }
+    if (self->flags & STACK_ARRAY) {
+        return stack_grow(self, size);
+    }
+    return stack_slab_new(self, size - self->pooled) != NULL;
+}
+/**
+ * @brief Limit how many pooled nodes a linked stack container keeps once it empties.
+ *
+ * Every time the stack empties, through stack_clear or its last stack_pop,
+ * slabs past the first limit nodes are handed back to the allocator.
+ *
+ * @param self  Stack container whose pool will be trimmed.
+ * @param limit High-water mark in nodes, SIZE_MAX (the default) keeps every slab.
+ */
+void stack_set_pool_limit(stack_t* const self, const size_t limit) {
+    if (!self) {
+        return;
+    }
+    self->pool_limit = limit;
+    if (!self->size) {
+        stack_pool_reset(self, limit);
+    }
+}
 /**
  * @brief Returns the current size of a stack container.
  *
@@ -138,9 +446,11 @@ void stack_clear(stack_t* const self) {
     if (!stack_status(self)) {
         return;
     }
-    const size_t self_size = self->size;
-    for (size_t i = 0; i < self_size; ++i) {
-        stack_pop(self);
+    self->size = 0;
+    self->top = NULL;
+    self->bottom = NULL;
+    if (!(self->flags & STACK_ARRAY)) {
+        stack_pool_reset(self, self->pool_limit);
     }
 }
 /**
@@ -149,14 +459,24 @@ void stack_clear(stack_t* const self) {
  * @param dst Stack container that will recieve the copied elements.
  * @param src Stack container whose elements will be copied.
  * 
- * @return Return dst containing a copy of all elements in src.
+ * @return Return dst containing a copy of all elements in src, or NULL leaving dst untouched
+ *         if the elements sizes differ, a STACK_VALUES dst would receive a NULL element or
+ *         a pointer dst would receive elements living inside a STACK_VALUES src. Return NULL
+ *         leaving dst empty if it runs out of memory, a dst created here is destroyed.
  */
 stack_t* stack_copy(stack_t* dst, stack_t* const src) {
-    if (!stack_status(src)) {
+    if (!stack_status(src) || dst == src) {
+        return dst == src ? dst : NULL;
+    }
+    // Reject before dst is touched. Pointers into the storage of a STACK_VALUES
+    // src would not outlive it.
+    if (dst && (dst->elements_size != src->elements_size || (dst->flags & STACK_VALUES && stack_holds_null(src)) ||
+                (src->flags & STACK_VALUES && !(dst->flags & STACK_VALUES)))) {
         return NULL;
     }
+    const bool created = !dst;
     if (!dst) {
-        dst = stack_init(src->elements_size);
+        dst = stack_init_flags(src->elements_size, src->flags);
         if (!dst) {
             return NULL;
         }
@@ -164,18 +484,48 @@ stack_t* stack_copy(stack_t* dst, stack_t* const src) {
     else {
         stack_clear(dst);
     }
-    stack_node* bottom = src->top;
-    size_t it = src->size;
+    stack_reserve(dst, src->size);
+    if (stack_capacity(dst) < src->size) {
+        if (created) {
+            stack_destroy(dst);
+        }
+        return NULL;
+    }
+    // A single top to bottom pass: array slots are filled from the end,
+    // linked nodes are appended below the previous one.
+    stack_node* node = src->top;
+    stack_node* tail = NULL;
     for (size_t i = 0; i < src->size; ++i) {
-        it -= i;
-        while (it > 1) {
-            bottom = bottom->next;
-            --it;
+        void* const element = src->flags & STACK_ARRAY ? stack_slot(src, src->size - 1 - i) : node->element;
+        if (!(src->flags & STACK_ARRAY)) {
+            node = node->next;
+        }
+        if (dst->flags & STACK_ARRAY) {
+            stack_slot_set(dst, src->size - 1 - i, element);
+            continue;
         }
-        stack_push(dst, bottom->element, src->elements_size);
-        bottom = src->top;
-        it = src->size;
+        stack_node* const copy = stack_node_new(dst, element);
+        if (!copy) {
+            // Leave dst empty rather than holding the top of src only.
+            dst->size = i;
+            stack_clear(dst);
+            if (created) {
+                stack_destroy(dst);
+            }
+            return NULL;
+        }
+        copy->next = NULL;
+        if (tail) {
+            tail->next = copy;
+        }
+        else {
+            dst->top = copy;
+        }
+        tail = copy;
+        dst->size = i + 1;
     }
+    dst->bottom = tail;
+    dst->size = src->size;
     return dst;
 }
 /**
@@ -203,46 +553,225 @@ void stack_pop(stack_t* const self) {
     if (!stack_status(self)) {
         return;
     }
-    if (self->size == 1) {
+    if (self->flags & STACK_ARRAY) {
         self->size--;
-        free(self->top);
-        self->top = NULL;
         return;
     }
-    self->size--;
     stack_node* current_node = self->top;
     self->top = self->top->next;
-    free(current_node);
+    if (!--self->size) {
+        self->bottom = NULL;
+        stack_pool_reset(self, self->pool_limit);
+        return;
+    }
+    current_node->next = self->free_nodes;
+    if (!self->free_nodes) {
+        self->free_tail = current_node;
+    }
+    self->free_nodes = current_node;
+}
+/**
+ * @brief Remove up to element_count elements from the top of a stack container.
+ *
+ * @param self          Stack container whose top elements will be removed.
+ * @param elements      Receives the removed elements, former top first, elements size bytes
+ *                      each. With pointer semantics the pointed elements are copied. May be NULL.
+ * @param element_count How many elements will be removed at most.
+ *
+ * @return Return how many elements were removed.
+ */
+size_t stack_pop_n(stack_t* const self, void* const elements, const size_t element_count) {
+    if (!stack_status(self) || !element_count) {
+        return 0;
+    }
+    const size_t count = element_count < self->size ? element_count : self->size;
+    uint8_t* out = elements;
+    if (self->flags & STACK_ARRAY) {
+        for (size_t i = 0; out && i < count; ++i, out += self->elements_size) {
+            stack_element_read(self, stack_slot(self, self->size - 1 - i), out);
+        }
+        self->size -= count;
+        return count;
+    }
+    if (count == self->size && !out) {
+        stack_clear(self);
+        return count;
+    }
+    for (size_t i = 0; i < count; ++i) {
+        if (out) {
+            stack_element_read(self, self->top->element, out);
+            out += self->elements_size;
+        }
+        stack_pop(self);
+    }
+    return count;
 }
 /**
  * @brief Add an element to the top of a stack container.
  * 
  * @param self Stack container that will hold the element.
- * @param element Element to be added to stack's top.
+ * @param element Element to be added to stack's top. With STACK_VALUES its bytes are copied,
+ *                otherwise the stack keeps the pointer and the caller keeps the element alive.
  * @param element_size Element size that will be added.
  */
 void stack_push(stack_t* const self, void* const element, const size_t element_size) {
-    if (!self || (self->elements_size > 1 && element_size != self->elements_size) || self->size == UINT64_MAX) {
+    if (!self || (self->elements_size > 1 && element_size != self->elements_size) || self->size == UINT64_MAX ||
+        (self->flags & STACK_VALUES && (!element || element_size != self->elements_size))) {
         return;
     }
-    if (!self->size) {
-        self->top = malloc(sizeof(stack_node));
-        if (!self->top) {
+    if (self->flags & STACK_ARRAY) {
+        if (!stack_make_room(self, 1)) {
             return;
         }
-        self->top->element = element;
-        self->top->next = NULL;
+        stack_slot_set(self, self->size++, element);
+        return;
     }
-    else {
-        stack_node* new_node = malloc(sizeof(stack_node));
-        if (!new_node) {
+    stack_node* new_node = stack_node_new(self, element);
+    if (!new_node) {
+        return;
+    }
+    new_node->next = self->top;
+    self->top = new_node;
+    if (!self->size++) {
+        self->bottom = new_node;
+    }
+}
+/**
+ * @brief Add a block of elements to the top of a stack container, the last one ending on top.
+ *
+ * @param self          Stack container that will hold the elements.
+ * @param elements      Pointer to the first of element_count contiguous elements. With pointer
+ *                      semantics the stack keeps a pointer into this block per element.
+ * @param element_size  Size of each element, must match the stack elements size.
+ * @param element_count How many elements will be added.
+ */
+void stack_push_n(stack_t* const self, void* const elements, const size_t element_size, const size_t element_count) {
+    if (!self || !elements || element_size != self->elements_size || !element_count || element_count > SIZE_MAX - self->size) {
+        return;
+    }
+    if (!stack_make_room(self, element_count)) {
+        return;
+    }
+    uint8_t* element = elements;
+    if (self->flags & STACK_ARRAY && self->flags & STACK_VALUES) {
+        memcpy(self->slots + self->size * self->elements_size, element, element_count * self->elements_size);
+        self->size += element_count;
+        return;
+    }
+    const size_t size = self->size;
+    for (size_t i = 0; i < element_count; ++i, element += self->elements_size) {
+        stack_push(self, element, self->elements_size);
+    }
+    // All or nothing: a node that could not be allocated takes the whole block back off.
+    if (self->size - size < element_count) {
+        stack_pop_n(self, NULL, self->size - size);
+    }
+}
+/**
+ * @brief Move every element of a stack container on top of another one, src top ending on top.
+ *
+ * Linked stacks of the same flags relink their nodes and hand their whole
+ * node pool, free nodes included, to dst in O(1). An empty STACK_ARRAY dst
+ * takes over the slots of src. Any other pair is moved
+ * element by element. Nothing moves if src holds a NULL element a
+ * STACK_VALUES dst cannot take, or if dst runs out of memory.
+ *
+ * @param dst Stack container that will receive the elements.
+ * @param src Stack container whose elements will be moved, left empty.
+ */
+void stack_splice(stack_t* const dst, stack_t* const src) {
+    // Pointers into the storage of a STACK_VALUES src would not outlive it.
+    if (!dst || !stack_status(src) || dst == src || dst->elements_size != src->elements_size ||
+        (src->flags & STACK_VALUES && !(dst->flags & STACK_VALUES))) {
+        return;
+    }
+    if (dst->flags != src->flags || (dst->flags & STACK_ARRAY && dst->size)) {
+        if (dst->flags & STACK_VALUES && stack_holds_null(src)) {
+            return;
+        }
+        if (!stack_make_room(dst, src->size)) {
+            return;
+        }
+        const size_t size = dst->size;
+        if (src->flags & STACK_ARRAY) {
+            for (size_t i = 0; i < src->size; ++i) {
+                stack_push(dst, stack_slot(src, i), src->elements_size);
+            }
+        }
+        else {
+            // Nodes only walk top to bottom, so gather them before pushing bottom first.
+            void** elements = malloc(src->size * sizeof(void*));
+            if (!elements) {
+                return;
+            }
+            size_t count = 0;
+            for (stack_node* node = src->top; node; node = node->next) {
+                elements[count++] = node->element;
+            }
+            while (count) {
+                stack_push(dst, elements[--count], src->elements_size);
+            }
+            free(elements);
+        }
+        if (dst->size - size < src->size) {
+            // A node could not be allocated, keep every element in src.
+            stack_pop_n(dst, NULL, dst->size - size);
             return;
         }
-        new_node->element = element;
-        new_node->next = self->top;
-        self->top = new_node;
+        stack_clear(src);
+        return;
+    }
+    if (dst->flags & STACK_ARRAY) {
+        // Empty array dst: trade slots with src.
+        uint8_t* const slots = dst->slots;
+        const size_t capacity = dst->capacity;
+        dst->slots = src->slots;
+        dst->capacity = src->capacity;
+        dst->size = src->size;
+        src->slots = slots;
+        src->capacity = capacity;
+        src->size = 0;
+        return;
+    }
+    // Slabs src carved from join the end of the carved part of the dst pool,
+    // keeping their carved counts so dst resumes where src stopped. Untouched
+    // slabs of src go after every slab of dst.
+    stack_slab* const spare = src->used_tail->next;
+    stack_slab** const link = dst->used_tail ? &dst->used_tail->next : &dst->slabs;
+    src->used_tail->next = *link;
+    *link = src->slabs;
+    if (dst->slabs_tail == dst->used_tail) {
+        dst->slabs_tail = src->used_tail;
+    }
+    dst->used_tail = src->used_tail;
+    if (spare) {
+        dst->slabs_tail->next = spare;
+        dst->slabs_tail = src->slabs_tail;
+    }
+    dst->pooled += src->pooled;
+    if (src->free_nodes) {
+        src->free_tail->next = dst->free_nodes;
+        if (!dst->free_nodes) {
+            dst->free_tail = src->free_tail;
+        }
+        dst->free_nodes = src->free_nodes;
+    }
+    src->bottom->next = dst->top;
+    if (!dst->size) {
+        dst->bottom = src->bottom;
     }
-    self->size++;
+    dst->top = src->top;
+    dst->size += src->size;
+    src->slabs = NULL;
+    src->slabs_tail = NULL;
+    src->used_tail = NULL;
+    src->current = NULL;
+    src->free_nodes = NULL;
+    src->free_tail = NULL;
+    src->pooled = 0;
+    src->top = NULL;
+    src->bottom = NULL;
+    src->size = 0;
 }
 /**
  * @brief Swap the content of two stack containers.
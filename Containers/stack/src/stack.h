@@ -27,12 +27,20 @@ SOFTWARE.
 #include <stdbool.h> // bool
 #include <stdint.h>  // Cross platform integer size
 
+/*
+ * stack_init_flags options.
+ */
+#define STACK_DEFAULT   0x0u // Linked nodes, one allocation per push.
+#define STACK_ARRAY     0x1u // Contiguous array with geometric growth, no allocation per push.
+#define STACK_VALUES    0x2u // Copy elements_size bytes per push, stack_top points into the stack.
+
 typedef struct _internal_stack stack_t;
 
 ///////////
 // Basic //
 ///////////
 stack_t*    stack_init(const size_t elements_size);
+stack_t*    stack_init_flags(const size_t elements_size, const uint32_t flags);
 void        stack_destroy(stack_t* const self);
 ////////////
 // Access //
@@ -42,6 +50,9 @@ void*       stack_top(stack_t* const self);
 //////////////
 // Capacity //
 //////////////
+size_t      stack_capacity(stack_t* const self);
+bool        stack_reserve(stack_t* const self, const size_t size);
+void        stack_set_pool_limit(stack_t* const self, const size_t limit);
 size_t      stack_size(stack_t* const self);
 /////////////////
 // Operations //
@@ -50,6 +61,9 @@ void        stack_clear(stack_t* const self);
 stack_t*    stack_copy(stack_t* dst, stack_t* const src);
 stack_t*    stack_move(stack_t* dst, stack_t* src);
 void        stack_pop(stack_t* const self);
+size_t      stack_pop_n(stack_t* const self, void* const elements, const size_t element_count);
 void        stack_push(stack_t* const self, void* const element, const size_t element_size);
+void        stack_push_n(stack_t* const self, void* const elements, const size_t element_size, const size_t element_count);
+void        stack_splice(stack_t* const dst, stack_t* const src);
 void        stack_swap(stack_t* const dst, stack_t* const src);
 #endif
@@ -0,0 +1,309 @@
+/*
+MIT License
+
+Copyright (c) 2018 Joseph Ojeda
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <stdatomic.h>  // atomic_uint_fast64_t, atomic_compare_exchange_weak
+#include <stddef.h>     // max_align_t
+#include <stdlib.h>     // malloc, aligned_alloc, free
+#include <string.h>     // memcpy
+
+#include "./stack_concurrent.h"
+
+#define _SEGMENTS_ 27           // 64 << 26 nodes, past the 32-bit index space.
+#define _FIRST_SEGMENT_SHIFT_ 6
+#define _MAX_BACKOFF_ 1024
+
+/*
+ * Nodes live in segments doubling in size that are only freed by
+ * stack_concurrent_destroy, so a thread still reading a popped node never
+ * touches freed memory. Nodes are named by a 32-bit index, 0 meaning none.
+ * Both list heads pack that index with a 32-bit tag bumped on every
+ * change, so a head that went A -> B -> A in between fails the
+ * compare-and-swap instead of corrupting the list.
+ */
+typedef struct stack_concurrent_node {
+    _Atomic uint32_t next;
+    max_align_t value[];
+} stack_concurrent_node;
+
+struct _internal_stack_concurrent {
+    size_t elements_size;
+    size_t node_size;
+    _Atomic(uint8_t*) segments[_SEGMENTS_];
+    _Alignas(64) _Atomic uint64_t top;
+    _Alignas(64) _Atomic uint64_t free_top;     // Recycled nodes.
+    _Alignas(64) _Atomic uint32_t carved;       // Nodes ever taken from segments.
+};
+
+/*
+ * Check if a concurrent stack is not null.
+ */
+static bool stack_concurrent_status(stack_concurrent_t* const self) {
+    return self != NULL;
+}
+
+static uint32_t head_index(const uint64_t head) {
+    return (uint32_t)head;
+}
+
+static uint64_t head_next(const uint64_t head, const uint32_t index) {
+    return ((head >> 32) + 1) << 32 | index;
+}
+
+static size_t segment_of(const uint32_t index) {
+    const uint64_t block = ((uint64_t)(index - 1) >> _FIRST_SEGMENT_SHIFT_) + 1;
+#if defined(__GNUC__)
+    return (size_t)(63 - __builtin_clzll(block));
+#else
+    size_t segment = 0;
+    while (block >> (segment + 1)) {
+        ++segment;
+    }
+    return segment;
+#endif
+}
+
+static size_t segment_start(const size_t segment) {
+    return ((size_t)1 << _FIRST_SEGMENT_SHIFT_) * (((size_t)1 << segment) - 1) + 1;
+}
+
+static stack_concurrent_node* stack_concurrent_node_at(stack_concurrent_t* const self, const uint32_t index) {
+    const size_t segment = segment_of(index);
+    uint8_t* const base = atomic_load_explicit(&self->segments[segment], memory_order_acquire);
+    return (stack_concurrent_node*)(base + (index - segment_start(segment)) * self->node_size);
+}
+
+static void stack_concurrent_backoff(unsigned* const spins) {
+    for (unsigned i = 0; i < *spins; ++i) {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#else
+        atomic_signal_fence(memory_order_seq_cst);
+#endif
+    }
+    if (*spins < _MAX_BACKOFF_) {
+        *spins <<= 1;
+    }
+}
+/*
+ * Link the chain first..last on top of a list head in one compare-and-swap.
+ */
+static void stack_concurrent_link(stack_concurrent_t* const self, _Atomic uint64_t* const head, const uint32_t first, const uint32_t last) {
+    stack_concurrent_node* const tail = stack_concurrent_node_at(self, last);
+    uint64_t old = atomic_load_explicit(head, memory_order_relaxed);
+    unsigned spins = 1;
+    for (;;) {
+        atomic_store_explicit(&tail->next, head_index(old), memory_order_relaxed);
+        if (atomic_compare_exchange_weak_explicit(head, &old, head_next(old, first), memory_order_release, memory_order_relaxed)) {
+            return;
+        }
+        stack_concurrent_backoff(&spins);
+    }
+}
+/*
+ * Unlink the first node of a list head, returning its index or 0 when empty.
+ */
+static uint32_t stack_concurrent_unlink(stack_concurrent_t* const self, _Atomic uint64_t* const head) {
+    uint64_t old = atomic_load_explicit(head, memory_order_acquire);
+    unsigned spins = 1;
+    for (;;) {
+        const uint32_t index = head_index(old);
+        if (!index) {
+            return 0;
+        }
+        // The node may be popped and reused meanwhile, the tag then fails the swap.
+        const uint32_t next = atomic_load_explicit(&stack_concurrent_node_at(self, index)->next, memory_order_relaxed);
+        if (atomic_compare_exchange_weak_explicit(head, &old, head_next(old, next), memory_order_acquire, memory_order_acquire)) {
+            return index;
+        }
+        stack_concurrent_backoff(&spins);
+    }
+}
+/*
+ * Take a recycled node, or carve a new one, allocating its segment if needed.
+ */
+static uint32_t stack_concurrent_node_new(stack_concurrent_t* const self) {
+    const uint32_t recycled = stack_concurrent_unlink(self, &self->free_top);
+    if (recycled) {
+        return recycled;
+    }
+    uint32_t carved = atomic_load_explicit(&self->carved, memory_order_relaxed);
+    do {
+        if (carved == UINT32_MAX) {
+            return 0;
+        }
+    } while (!atomic_compare_exchange_weak_explicit(&self->carved, &carved, carved + 1, memory_order_relaxed, memory_order_relaxed));
+    const uint32_t index = carved + 1;
+    const size_t segment = segment_of(index);
+    if (!atomic_load_explicit(&self->segments[segment], memory_order_acquire)) {
+        const size_t count = (size_t)1 << (_FIRST_SEGMENT_SHIFT_ + segment);
+        uint8_t* fresh = malloc(count * self->node_size);
+        if (!fresh) {
+            // The index stays carved but unused, it was never handed out.
+            return 0;
+        }
+        uint8_t* expected = NULL;
+        if (!atomic_compare_exchange_strong_explicit(&self->segments[segment], &expected, fresh, memory_order_acq_rel, memory_order_acquire)) {
+            free(fresh);
+        }
+    }
+    return index;
+}
+///////////
+// Basic //
+///////////
+/**
+ * @brief Initialize a new concurrent stack container.
+ *
+ * @param elements_size What kind of variables is going to hold the stack container.
+ *
+ * @return A new concurrent stack container.
+ */
+stack_concurrent_t* stack_concurrent_init(const size_t elements_size) {
+    if (!elements_size) {
+        return NULL;
+    }
+    stack_concurrent_t* init = aligned_alloc(64, sizeof(stack_concurrent_t));
+    if (!init) {
+        return NULL;
+    }
+    init->elements_size = elements_size;
+    const size_t bytes = sizeof(stack_concurrent_node) + elements_size;
+    init->node_size = (bytes + _Alignof(max_align_t) - 1) / _Alignof(max_align_t) * _Alignof(max_align_t);
+    for (size_t i = 0; i < _SEGMENTS_; ++i) {
+        atomic_init(&init->segments[i], NULL);
+    }
+    atomic_init(&init->top, 0);
+    atomic_init(&init->free_top, 0);
+    atomic_init(&init->carved, 0);
+    return init;
+}
+/**
+ * @brief Free every node plus the concurrent stack itself. No other thread may use it anymore.
+ *
+ * @param self The concurrent stack to be freed.
+ */
+void stack_concurrent_destroy(stack_concurrent_t* const self) {
+    if (!stack_concurrent_status(self)) {
+        return;
+    }
+    for (size_t i = 0; i < _SEGMENTS_; ++i) {
+        free(atomic_load_explicit(&self->segments[i], memory_order_relaxed));
+    }
+    free(self);
+}
+////////////
+// Access //
+////////////
+/**
+ * @brief Returns if a concurrent stack has any element at all.
+ *
+ * @param self Concurrent stack to check elements from.
+ *
+ * @return Return true if self is empty. Only a hint while other threads use it.
+ */
+bool stack_concurrent_is_empty(stack_concurrent_t* const self) {
+    if (!stack_concurrent_status(self)) {
+        return true;
+    }
+    return !head_index(atomic_load_explicit(&self->top, memory_order_acquire));
+}
+/////////////////
+// Operations //
+////////////////
+/**
+ * @brief Remove the element at the top of a concurrent stack, from any thread.
+ *
+ * @param self      Concurrent stack whose top element will be removed.
+ * @param element   Receives the removed element, elements size bytes.
+ *
+ * @return Return true if an element was removed, false if self was empty.
+ */
+bool stack_concurrent_pop(stack_concurrent_t* const self, void* const element) {
+    if (!stack_concurrent_status(self) || !element) {
+        return false;
+    }
+    const uint32_t index = stack_concurrent_unlink(self, &self->top);
+    if (!index) {
+        return false;
+    }
+    memcpy(element, stack_concurrent_node_at(self, index)->value, self->elements_size);
+    stack_concurrent_link(self, &self->free_top, index, index);
+    return true;
+}
+/**
+ * @brief Detach every element of a concurrent stack in one step and visit them, top first.
+ *
+ * Pushes racing with the call land on the now empty stack, never in the detached batch.
+ *
+ * @param self      Concurrent stack whose elements will be removed.
+ * @param function  Function called once per removed element. May be NULL.
+ * @param context   Pointer handed unchanged to every function call.
+ *
+ * @return Return how many elements were removed.
+ */
+size_t stack_concurrent_pop_all(stack_concurrent_t* const self, void (*function)(void* const element, void* const context), void* const context) {
+    if (!stack_concurrent_status(self)) {
+        return 0;
+    }
+    uint64_t old = atomic_load_explicit(&self->top, memory_order_relaxed);
+    while (head_index(old) && !atomic_compare_exchange_weak_explicit(&self->top, &old, head_next(old, 0), memory_order_acquire, memory_order_relaxed)) {
+    }
+    const uint32_t first = head_index(old);
+    if (!first) {
+        return 0;
+    }
+    size_t count = 0;
+    uint32_t last = first;
+    for (uint32_t index = first; index; ++count) {
+        stack_concurrent_node* const node = stack_concurrent_node_at(self, index);
+        if (function) {
+            function(node->value, context);
+        }
+        last = index;
+        index = atomic_load_explicit(&node->next, memory_order_relaxed);
+    }
+    stack_concurrent_link(self, &self->free_top, first, last);
+    return count;
+}
+/**
+ * @brief Add an element to the top of a concurrent stack, from any thread.
+ *
+ * @param self          Concurrent stack that will hold the element.
+ * @param element       Element to be copied onto the stack's top.
+ * @param element_size  Element size, must match the stack elements size.
+ *
+ * @return Return true if the element was added, false if no node could be allocated.
+ */
+bool stack_concurrent_push(stack_concurrent_t* const self, const void* const element, const size_t element_size) {
+    if (!stack_concurrent_status(self) || !element || element_size != self->elements_size) {
+        return false;
+    }
+    const uint32_t index = stack_concurrent_node_new(self);
+    if (!index) {
+        return false;
+    }
+    memcpy(stack_concurrent_node_at(self, index)->value, element, self->elements_size);
+    stack_concurrent_link(self, &self->top, index, index);
+    return true;
+}
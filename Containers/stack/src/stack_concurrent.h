@@ -0,0 +1,53 @@
+/*
+MIT License
+
+Copyright (c) 2018 Joseph Ojeda
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef _STACK_CONCURRENT_H
+#define _STACK_CONCURRENT_H
+
+#include <stdbool.h> // bool
+#include <stdint.h>  // Cross platform integer size
+
+/*
+ * Lock-free LIFO for any number of threads. Elements are copied in and
+ * out, elements_size bytes each, since no pointer into the stack could
+ * stay valid while other threads pop.
+ */
+typedef struct _internal_stack_concurrent stack_concurrent_t;
+
+///////////
+// Basic //
+///////////
+stack_concurrent_t* stack_concurrent_init(const size_t elements_size);
+void                stack_concurrent_destroy(stack_concurrent_t* const self);
+////////////
+// Access //
+////////////
+bool                stack_concurrent_is_empty(stack_concurrent_t* const self);
+/////////////////
+// Operations //
+////////////////
+bool                stack_concurrent_pop(stack_concurrent_t* const self, void* const element);
+size_t              stack_concurrent_pop_all(stack_concurrent_t* const self, void (*function)(void* const element, void* const context), void* const context);
+bool                stack_concurrent_push(stack_concurrent_t* const self, const void* const element, const size_t element_size);
+#endif
@@ -22,11 +22,51 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.
 */
 
+#include <pthread.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <limits.h>
 
 #include "./src/stack.h"
+#include "./src/stack_concurrent.h"
+
+static void print_int(void* const element, void* const context) {
+    (void)context;
+    printf(" %d", *(int*)element);
+}
+
+#define WORKERS 4
+#define PUSHED 10000
+
+typedef struct worker {
+    stack_concurrent_t* stack;
+    long count;
+    long sum;
+} worker;
+
+static void count_int(void* const element, void* const context) {
+    worker* const self = context;
+    self->count++;
+    self->sum += *(int*)element;
+}
+/*
+ * Push 1 to PUSHED, popping one element after every other push and
+ * draining the whole stack every 1000 pushes, keeping what was taken.
+ */
+static void* work(void* const argument) {
+    worker* const self = argument;
+    for (int i = 1; i <= PUSHED; ++i) {
+        stack_concurrent_push(self->stack, &i, sizeof(int));
+        int value = 0;
+        if (i % 2 && stack_concurrent_pop(self->stack, &value)) {
+            count_int(&value, self);
+        }
+        if (i % 1000 == 0) {
+            stack_concurrent_pop_all(self->stack, count_int, self);
+        }
+    }
+    return NULL;
+}
 
 int main(void) {
     // Test
@@ -104,8 +144,111 @@ int main(void) {
     printf("\t\t\tstack_size(stack2) = %ld\n", stack_size(stack2));
     printf("\t\t\tstack_top(stack2)  = %d\n", *(uint8_t*)stack_top(stack2));*/
 
+    //stack_init_flags
+    puts("\tstack stack_init_flags(uint8_t elements_size, uint32_t flags):");
+    stack_t* stack4 = stack_init_flags(sizeof(uint8_t), STACK_ARRAY);
+    puts("\t\tstack stack4 = stack_init_flags(sizeof(uint8_t), STACK_ARRAY)");
+    stack_reserve(stack4, 16);
+    puts("\t\tstack_reserve(stack4, 16)");
+    printf("\t\t\tstack_capacity(stack4) = %ld\n", stack_capacity(stack4));
+    stack_push(stack4, &stack1_element1, sizeof(uint8_t));
+    stack_push(stack4, &stack1_element2, sizeof(uint8_t));
+    puts("\t\tstack_push(stack4, &stack1_element1, sizeof(uint8_t))");
+    puts("\t\tstack_push(stack4, &stack1_element2, sizeof(uint8_t))");
+    printf("\t\t\tstack_size(stack4) = %ld\n", stack_size(stack4));
+    printf("\t\t\tstack_top(stack4)  = %d\n", *(uint8_t*)stack_top(stack4));
+    stack_pop(stack4);
+    puts("\t\tstack_pop(stack4)");
+    printf("\t\t\tstack_size(stack4) = %ld\n", stack_size(stack4));
+    printf("\t\t\tstack_top(stack4)  = %d\n", *(uint8_t*)stack_top(stack4));
+
+    stack_t* stack5 = stack_init_flags(sizeof(int), STACK_ARRAY | STACK_VALUES);
+    puts("\t\tstack stack5 = stack_init_flags(sizeof(int), STACK_ARRAY | STACK_VALUES)");
+    for (int i = 0; i < 10; ++i) {
+        stack_push(stack5, &i, sizeof(int));
+    }
+    puts("\t\tstack_push(stack5, &i, sizeof(int)) for i in [0, 10)");
+    printf("\t\t\tstack_size(stack5) = %ld\n", stack_size(stack5));
+    printf("\t\t\tstack_top(stack5)  = %d\n", *(int*)stack_top(stack5));
+
+    stack_t* stack6 = stack_init_flags(sizeof(int), STACK_VALUES);
+    puts("\t\tstack stack6 = stack_init_flags(sizeof(int), STACK_VALUES)");
+    stack_set_pool_limit(stack6, 64);
+    puts("\t\tstack_set_pool_limit(stack6, 64)");
+    for (int i = 0; i < 1000; ++i) {
+        stack_push(stack6, &i, sizeof(int));
+    }
+    puts("\t\tstack_push(stack6, &i, sizeof(int)) for i in [0, 1000)");
+    printf("\t\t\tstack_capacity(stack6) = %ld\n", stack_capacity(stack6));
+    stack_clear(stack6);
+    puts("\t\tstack_clear(stack6)");
+    printf("\t\t\tstack_capacity(stack6) = %ld\n", stack_capacity(stack6));
+
+    int block[] = { 1, 2, 3, 4, 5 };
+    stack_push_n(stack6, block, sizeof(int), 5);
+    puts("\t\tstack_push_n(stack6, {1, 2, 3, 4, 5}, sizeof(int), 5)");
+    printf("\t\t\tstack_top(stack6)  = %d\n", *(int*)stack_top(stack6));
+    stack_t* stack7 = stack_copy(NULL, stack6);
+    puts("\t\tstack stack7 = stack_copy(NULL, stack6)");
+    stack_splice(stack6, stack7);
+    puts("\t\tstack_splice(stack6, stack7)");
+    printf("\t\t\tstack_size(stack6) = %ld\n", stack_size(stack6));
+    printf("\t\t\tstack_size(stack7) = %ld\n", stack_size(stack7));
+    printf("\t\t\tstack_capacity(stack7) = %ld\n", stack_capacity(stack7));
+    int popped[3];
+    printf("\t\tstack_pop_n(stack6, popped, 3) = %ld\n", stack_pop_n(stack6, popped, 3));
+    printf("\t\t\tpopped = { %d, %d, %d }\n", popped[0], popped[1], popped[2]);
+    printf("\t\t\tstack_top(stack6)  = %d\n", *(int*)stack_top(stack6));
+
+    stack_concurrent_t* stack8 = stack_concurrent_init(sizeof(int));
+    puts("\t\tstack_concurrent stack8 = stack_concurrent_init(sizeof(int))");
+    for (int i = 0; i < 5; ++i) {
+        stack_concurrent_push(stack8, &i, sizeof(int));
+    }
+    puts("\t\tstack_concurrent_push(stack8, &i, sizeof(int)) for i in [0, 5)");
+    int value = 0;
+    stack_concurrent_pop(stack8, &value);
+    printf("\t\tstack_concurrent_pop(stack8, &value), value = %d\n", value);
+    printf("\t\tstack_concurrent_pop_all(stack8, print_int, NULL):");
+    size_t drained = stack_concurrent_pop_all(stack8, print_int, NULL);
+    printf("\n\t\t\tdrained = %ld\n", drained);
+    printf("\t\t\tstack_concurrent_is_empty(stack8) = %d\n", stack_concurrent_is_empty(stack8));
+
+    worker workers[WORKERS + 1] = { 0 };
+    pthread_t threads[WORKERS];
+    for (int i = 0; i <= WORKERS; ++i) {
+        workers[i].stack = stack8;
+    }
+    for (int i = 0; i < WORKERS; ++i) {
+        pthread_create(&threads[i], NULL, work, &workers[i]);
+    }
+    for (int i = 0; i < WORKERS; ++i) {
+        pthread_join(threads[i], NULL);
+    }
+    // The last slot drains whatever the workers left behind.
+    stack_concurrent_pop_all(stack8, count_int, &workers[WORKERS]);
+    long count = 0;
+    long sum = 0;
+    for (int i = 0; i <= WORKERS; ++i) {
+        count += workers[i].count;
+        sum += workers[i].sum;
+    }
+    const long expected = (long)PUSHED * (PUSHED + 1) / 2 * WORKERS;
+    printf("\t\t%d threads pushing and popping stack8:\n", WORKERS);
+    printf("\t\t\tpopped = %ld (expected %d)\n", count, WORKERS * PUSHED);
+    printf("\t\t\tsum    = %ld (expected %ld)\n", sum, expected);
+    if (count != WORKERS * PUSHED || sum != expected) {
+        puts("stack8 lost or duplicated elements");
+        return EXIT_FAILURE;
+    }
+
     stack_destroy(stack1);
     //stack_destroy(stack2);
     stack_destroy(stack3);
+    stack_destroy(stack4);
+    stack_destroy(stack5);
+    stack_destroy(stack6);
+    stack_destroy(stack7);
+    stack_concurrent_destroy(stack8);
     return EXIT_SUCCESS;
 }
\ No newline at end of file
@@ -0,0 +1,172 @@
+/*
+MIT License
+
+Copyright (c) 2018 Joseph Ojeda
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#define _POSIX_C_SOURCE 199309L // clock_gettime, CLOCK_MONOTONIC
+
+#include <stdio.h>  // printf, puts
+#include <stdlib.h> // malloc, free, EXIT_SUCCESS
+#include <time.h>   // clock_gettime
+
+#include "./src/vector.h"
+
+#define BENCH_ELEMENTS 1000000
+#define BENCH_ROUNDS 5   // Each timing is the best of this many runs.
+
+/*
+ * Reference byte-at-a-time loop, the copy every vector operation used to go through.
+ */
+static void* byte_copy(void* const dest, const void* const src, size_t bytes) {
+    char* dest_temp = dest;
+    const char *src_temp = src;
+    while (bytes--) {
+        *dest_temp++ = *src_temp++;
+    }
+    return dest;
+}
+
+static void* byte_set(void* const src, int value, size_t bytes) {
+    uint8_t* temp = src;
+    while (bytes--) {
+        *temp++ = (uint8_t)value;
+    }
+    return src;
+}
+/*
+ * The push_back the vector shipped with before the copy kernels: 1.5x growth
+ * that zeroes spare slots, and a byte loop per element.
+ */
+typedef struct baseline_vector {
+    size_t capacity;
+    size_t size;
+    size_t elements_size;
+    uint8_t* elements;
+} baseline_vector;
+
+static void baseline_reserve(baseline_vector* const self, const size_t size) {
+    if (self->capacity < size) {
+        const size_t capacity = (size_t)(size * 1.5f);
+        uint8_t* temp = realloc(self->elements, self->elements_size * capacity);
+        if (!temp) {
+            return;
+        }
+        self->elements = temp;
+        for (size_t i = self->size; i < capacity; ++i) {
+            byte_set(self->elements + i * self->elements_size, 0, self->elements_size);
+        }
+        self->capacity = capacity;
+    }
+}
+
+// Kept out of line, as the library call it stands for was.
+__attribute__((noinline)) static void baseline_push_back(baseline_vector* const self, const void* const element) {
+    if (self->size + 1 >= self->capacity) {
+        baseline_reserve(self, self->capacity + 1);
+        if (self->size + 1 >= self->capacity) {
+            return;
+        }
+    }
+    byte_copy(self->elements + self->size * self->elements_size, element, self->elements_size);
+    self->size++;
+}
+
+static double elapsed_ms(const struct timespec* const start) {
+    struct timespec end;
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    return (end.tv_sec - start->tv_sec) * 1e3 + (end.tv_nsec - start->tv_nsec) / 1e6;
+}
+
+static void bench(const size_t elements_size) {
+    uint8_t* record = malloc(elements_size);
+    uint8_t* reference = malloc(elements_size * BENCH_ELEMENTS);
+    if (!record || !reference) {
+        free(record);
+        free(reference);
+        return;
+    }
+    for (size_t i = 0; i < elements_size; ++i) {
+        record[i] = (uint8_t)i;
+    }
+    struct timespec start;
+
+    // Touch every page once so neither side pays for page faults.
+    for (size_t i = 0; i < BENCH_ELEMENTS; ++i) {
+        byte_copy(reference + i * elements_size, record, elements_size);
+    }
+    double byte_loop = 0;
+    for (size_t round = 0; round < BENCH_ROUNDS; ++round) {
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        for (size_t i = 0; i < BENCH_ELEMENTS; ++i) {
+            byte_copy(reference + i * elements_size, record, elements_size);
+        }
+        const double ms = elapsed_ms(&start);
+        byte_loop = round && byte_loop < ms ? byte_loop : ms;
+    }
+
+    baseline_vector baseline = { 0, 0, elements_size, NULL };
+    baseline_reserve(&baseline, BENCH_ELEMENTS + 1);
+    double baseline_push = 0;
+    for (size_t round = 0; round < BENCH_ROUNDS; ++round) {
+        baseline.size = 0;
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        for (size_t i = 0; i < BENCH_ELEMENTS; ++i) {
+            baseline_push_back(&baseline, record);
+        }
+        const double ms = elapsed_ms(&start);
+        baseline_push = round && baseline_push < ms ? baseline_push : ms;
+    }
+    free(baseline.elements);
+
+    vector_t* vector = vector_init(elements_size, BENCH_ELEMENTS);
+    vector_assign(vector, record, elements_size, BENCH_ELEMENTS);
+    double push_back = 0;
+    for (size_t round = 0; round < BENCH_ROUNDS; ++round) {
+        vector_clear(vector);
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        for (size_t i = 0; i < BENCH_ELEMENTS; ++i) {
+            vector_push_back(vector, record, elements_size);
+        }
+        const double ms = elapsed_ms(&start);
+        push_back = round && push_back < ms ? push_back : ms;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    vector_assign(vector, record, elements_size, BENCH_ELEMENTS);
+    const double assign = elapsed_ms(&start);
+
+    printf("\t%4zu bytes: byte loop %8.2f ms | baseline push_back %8.2f ms | vector_push_back %8.2f ms | vector_assign %8.2f ms\n",
+           elements_size, byte_loop, baseline_push, push_back, assign);
+
+    vector_destroy(vector);
+    free(reference);
+    free(record);
+}
+
+int main(void) {
+    printf("Vector copy/fill kernels, %d elements:\n", BENCH_ELEMENTS);
+    const size_t sizes[] = { 1, 2, 4, 8, 16, 24, 64, 256 };
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i) {
+        bench(sizes[i]);
+    }
+    return EXIT_SUCCESS;
+}
@@ -22,27 +22,132 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.
 */
 
-#include <stdlib.h>
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE // mremap
+#endif
+
+#include <fcntl.h>      // open
+#ifdef __GLIBC__
+#include <malloc.h>     // malloc_usable_size
+#endif
+#include <stdatomic.h>  // atomic_size_t, atomic_fetch_add
+#include <stddef.h>     // max_align_t
+#include <stdlib.h>     // malloc, realloc, free
+#include <string.h>     // memcpy, memmove, memset
+#include <sys/mman.h>   // mmap, mremap, munmap, madvise, msync
+#include <sys/stat.h>   // fstat
+#include <unistd.h>     // sysconf, ftruncate, close
 
 #include "./vector.h"
 
-static const float _GROWTH_FACTOR_ = 1.5f;
+static const vector_growth_t _DEFAULT_GROWTH_ = VECTOR_GROWTH_DEFAULT;
+
+#define _VECTOR_FILE_ 0x80000000u   // Internal flag, storage is a shared file mapping.
+#define _FILE_HEADER_ 64            // Bytes before the first element, keeps elements cache-line aligned.
+
+#if defined(__GNUC__)
+#define _COLD_ __attribute__((noinline, cold))
+#else
+#define _COLD_
+#endif
+
+static const char _FILE_MAGIC_[8] = { 'C', 'U', 'V', 'E', 'C', 'T', 'O', 'R' };
+
+/*
+ * On-disk header of vector_open_file, at offset 0 of the file.
+ */
+typedef struct vector_file_header {
+    char magic[8];
+    uint64_t elements_size;
+    uint64_t size;
+    uint64_t capacity;
+} vector_file_header;
+
+/*
+ * Reference count of a heap buffer shared by vector_copy. Shared buffers are
+ * read-only, the first mutation through any owner gives it a private copy.
+ */
+typedef struct vector_shared {
+    atomic_size_t references;
+} vector_shared;
+
+/*
+ * Element copy/fill kernels. One set is picked at vector_init from
+ * elements_size so hot paths never loop byte by byte. Counts are in elements.
+ */
+typedef struct vector_kernel {
+    void (*copy)(void* const dest, const void* const src, const size_t count, const size_t elements_size);
+    void (*fill)(void* const dest, const void* const element, const size_t count, const size_t elements_size);
+} vector_kernel;
+
+typedef struct { uint64_t low, high; } uint128_pair_t;
+
+#define _VECTOR_KERNEL_(bytes, type)                                                                         \
+    static void copy_##bytes(void* const dest, const void* const src, const size_t count, const size_t elements_size) { \
+        (void)elements_size;                                                                                 \
+        memcpy(dest, src, count * bytes);                                                                    \
+    }                                                                                                        \
+    static void fill_##bytes(void* const dest, const void* const element, const size_t count, const size_t elements_size) { \
+        (void)elements_size;                                                                                 \
+        type value;                                                                                          \
+        memcpy(&value, element, bytes);                                                                      \
+        uint8_t* temp = dest;                                                                                \
+        for (size_t i = 0; i < count; ++i) {                                                                 \
+            memcpy(temp + i * bytes, &value, bytes);                                                         \
+        }                                                                                                    \
+    }
+
+_VECTOR_KERNEL_(1, uint8_t)
+_VECTOR_KERNEL_(2, uint16_t)
+_VECTOR_KERNEL_(4, uint32_t)
+_VECTOR_KERNEL_(8, uint64_t)
+_VECTOR_KERNEL_(16, uint128_pair_t)
+
+/*
+ * Any other record size is moved as one block; libc memcpy picks the widest
+ * SIMD path available on the running CPU.
+ */
+static void copy_block(void* const dest, const void* const src, const size_t count, const size_t elements_size) {
+    memcpy(dest, src, count * elements_size);
+}
 
-static void* memory_copy(void* const dest, const void* const src, size_t bytes) {
-    char* dest_temp = dest;
-    const char *src_temp = src;
-    while (bytes--) {
-        *dest_temp++ = *src_temp++;
+/*
+ * Fill by doubling: write one element, then keep copying the already filled
+ * prefix onto the rest so every pass is a wide block copy.
+ */
+static void fill_block(void* const dest, const void* const element, const size_t count, const size_t elements_size) {
+    if (!count) {
+        return;
+    }
+    const size_t bytes = count * elements_size;
+    uint8_t* temp = dest;
+    memcpy(temp, element, elements_size);
+    size_t filled = elements_size;
+    while (filled < bytes) {
+        const size_t chunk = filled < bytes - filled ? filled : bytes - filled;
+        memcpy(temp + filled, temp, chunk);
+        filled += chunk;
     }
-    return dest;
 }
 
-static void* memory_set(void* const src, int value, size_t bytes) {
-    uint8_t* temp = src;
-    while (bytes--) {
-        *temp++ = (uint8_t)value;
+static const vector_kernel _KERNELS_[] = {
+    { copy_1, fill_1 },
+    { copy_2, fill_2 },
+    { copy_4, fill_4 },
+    { copy_8, fill_8 },
+    { copy_16, fill_16 },
+    { copy_block, fill_block }
+};
+
+static const vector_kernel* vector_kernel_select(const size_t elements_size) {
+    switch (elements_size) {
+        case 1:  return &_KERNELS_[0];
+        case 2:  return &_KERNELS_[1];
+        case 4:  return &_KERNELS_[2];
+        case 8:  return &_KERNELS_[3];
+        case 16: return &_KERNELS_[4];
+        default: return &_KERNELS_[5];
     }
-    return src;
 }
 
 struct _internal_vector {
@@ -50,6 +155,15 @@ struct _internal_vector {
     size_t size;
     size_t elements_size;
     void* elements;
+    const vector_kernel* kernel;
+    uint32_t flags;
+    size_t mapped;
+    int fd;
+    vector_growth_t growth;
+    vector_stats_t stats;
+    vector_shared* _Atomic shared;  // Set while elements may be shared with other vectors.
+    size_t inline_capacity;
+    max_align_t inline_elements[];  // Small buffer of vector_init_small, inline_capacity elements.
 };
 /*
  * Check if a vector and it's elements are not null.
@@ -57,6 +171,298 @@ struct _internal_vector {
 static bool vector_status(vector_t* const self){
     return self && self->elements ? true : false;
 }
+/*
+ * Check if a vector elements live in its own small buffer.
+ */
+static bool vector_is_inline(vector_t* const self) {
+    return self->inline_capacity && self->elements == (void*)self->inline_elements;
+}
+/*
+ * Zero count slots starting at index, unless the vector opted out of zeroing.
+ */
+static void vector_zero(vector_t* const self, const size_t index, const size_t count) {
+    if (self->flags & VECTOR_UNINITIALIZED || !count) {
+        return;
+    }
+    memset(self->elements + index * self->elements_size, 0, count * self->elements_size);
+}
+static size_t vector_page_round(const size_t bytes) {
+    const size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    return (bytes + page - 1) / page * page;
+}
+/*
+ * Grow a VECTOR_MMAP buffer. Anonymous pages arrive zeroed and mremap moves
+ * the mapping without copying, so growth never holds two buffers at once.
+ * Pages released by vector_shrink_to_fit stay mapped and are reused here.
+ */
+static bool vector_grow_mapped(vector_t* const self, const size_t capacity) {
+    const size_t bytes = vector_page_round(capacity * self->elements_size);
+    const size_t rounded = self->growth.round_to_allocator ? bytes / self->elements_size : capacity;
+    if (self->elements && bytes <= self->mapped) {
+        self->capacity = rounded;
+        return true;
+    }
+    void* temp = MAP_FAILED;
+    if (!self->elements) {
+        temp = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    }
+    else {
+#ifdef MREMAP_MAYMOVE
+        temp = mremap(self->elements, self->mapped, bytes, MREMAP_MAYMOVE);
+#else
+        temp = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (temp != MAP_FAILED) {
+            self->kernel->copy(temp, self->elements, self->size, self->elements_size);
+            munmap(self->elements, self->mapped);
+            self->stats.bytes_moved += self->size * self->elements_size;
+        }
+#endif
+    }
+    if (temp == MAP_FAILED) {
+        return false;
+    }
+#ifdef MADV_HUGEPAGE
+    if (self->flags & VECTOR_HUGEPAGES) {
+        madvise(temp, bytes, MADV_HUGEPAGE);
+    }
+#endif
+    self->elements = temp;
+    self->mapped = bytes;
+    self->capacity = rounded;
+    self->stats.reallocations++;
+    return true;
+}
+static vector_file_header* vector_file_header_of(vector_t* const self) {
+    return (vector_file_header*)((uint8_t*)self->elements - _FILE_HEADER_);
+}
+/*
+ * Resize a file-backed vector to hold capacity slots: the file is resized
+ * with ftruncate and the shared mapping follows with mremap. New file space
+ * reads as zero.
+ */
+static bool vector_remap_file(vector_t* const self, const size_t capacity) {
+    const size_t bytes = _FILE_HEADER_ + capacity * self->elements_size;
+    uint8_t* const base = (uint8_t*)vector_file_header_of(self);
+    if (bytes > self->mapped && ftruncate(self->fd, (off_t)bytes)) {
+        return false;
+    }
+#ifdef MREMAP_MAYMOVE
+    void* temp = mremap(base, self->mapped, bytes, MREMAP_MAYMOVE);
+#else
+    void* temp = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, self->fd, 0);
+    if (temp != MAP_FAILED) {
+        munmap(base, self->mapped);
+    }
+#endif
+    if (temp == MAP_FAILED) {
+        return false;
+    }
+    if (bytes < self->mapped) {
+        ftruncate(self->fd, (off_t)bytes);
+    }
+    self->elements = (uint8_t*)temp + _FILE_HEADER_;
+    self->mapped = bytes;
+    self->capacity = capacity;
+    self->stats.reallocations++;
+    vector_file_header_of(self)->capacity = capacity;
+    return true;
+}
+/*
+ * Give up a reference to a shared buffer, the last owner frees it.
+ */
+static void vector_drop_shared(vector_t* const self) {
+    if (atomic_fetch_sub_explicit(&self->shared->references, 1, memory_order_acq_rel) == 1) {
+        free(self->elements);
+        free(self->shared);
+    }
+    self->shared = NULL;
+}
+/*
+ * Make self the only owner of its elements. A buffer still referenced
+ * elsewhere is copied into a private one of the given capacity.
+ */
+static bool vector_detach(vector_t* const self, const size_t capacity) {
+    if (atomic_load_explicit(&self->shared->references, memory_order_acquire) == 1) {
+        free(self->shared);
+        self->shared = NULL;
+        return true;
+    }
+    void* temp = self->flags & VECTOR_ZERO_PAGES ? calloc(capacity, self->elements_size) : malloc(capacity * self->elements_size);
+    if (!temp) {
+        return false;
+    }
+    self->kernel->copy(temp, self->elements, self->size, self->elements_size);
+    self->stats.bytes_moved += self->size * self->elements_size;
+    self->stats.reallocations++;
+    vector_drop_shared(self);
+    self->elements = temp;
+    self->capacity = capacity;
+    if (!(self->flags & VECTOR_ZERO_PAGES)) {
+        vector_zero(self, self->size, capacity - self->size);
+    }
+    return true;
+}
+/*
+ * Check if self may write its elements, detaching them from a shared buffer first.
+ */
+static bool vector_writable(vector_t* const self) {
+    return !self->shared || vector_detach(self, self->capacity);
+}
+/*
+ * Return the elements buffer to wherever it came from.
+ */
+static void vector_release(vector_t* const self) {
+    if (!self->elements) {
+        return;
+    }
+    if (self->shared) {
+        vector_drop_shared(self);
+    }
+    else if (self->flags & _VECTOR_FILE_) {
+        vector_file_header_of(self)->size = self->size;
+        munmap(vector_file_header_of(self), self->mapped);
+        close(self->fd);
+        self->fd = -1;
+    }
+    else if (self->flags & VECTOR_MMAP) {
+        munmap(self->elements, self->mapped);
+    }
+    else if (!vector_is_inline(self)) {
+        free(self->elements);
+    }
+    self->elements = NULL;
+    self->capacity = 0;
+    self->mapped = 0;
+}
+/*
+ * Reallocate the elements buffer to hold capacity slots. Slots past the old
+ * capacity are zeroed eagerly, left untouched, or come from calloc pages
+ * depending on the vector flags. A small buffer is never reallocated, its
+ * elements are copied out to the heap instead. A capacity whose byte size
+ * overflows is refused.
+ */
+static bool vector_grow(vector_t* const self, const size_t capacity) {
+    if (capacity > SIZE_MAX / self->elements_size) {
+        return false;
+    }
+    if (self->flags & _VECTOR_FILE_) {
+        return vector_remap_file(self, capacity);
+    }
+    if (self->flags & VECTOR_MMAP) {
+        return vector_grow_mapped(self, capacity);
+    }
+    if (self->shared) {
+        // A buffer still referenced elsewhere is copied straight into the grown one.
+        if (!vector_detach(self, capacity)) {
+            return false;
+        }
+        if (self->capacity == capacity) {
+            return true;
+        }
+    }
+    const bool spill = self->elements && vector_is_inline(self);
+    size_t old_capacity = self->elements ? self->capacity : 0;
+    void* temp = NULL;
+    if (self->flags & VECTOR_ZERO_PAGES || spill) {
+        temp = self->flags & VECTOR_ZERO_PAGES ? calloc(capacity, self->elements_size) : malloc(capacity * self->elements_size);
+        if (!temp) {
+            return false;
+        }
+        if (self->elements) {
+            self->kernel->copy(temp, self->elements, self->size, self->elements_size);
+            self->stats.bytes_moved += self->size * self->elements_size;
+            if (!spill) {
+                free(self->elements);
+            }
+        }
+        old_capacity = self->size;
+    }
+    else {
+        temp = realloc(self->elements, capacity * self->elements_size);
+        if (!temp) {
+            return false;
+        }
+        if (self->elements && temp != self->elements) {
+            self->stats.bytes_moved += self->size * self->elements_size;
+        }
+    }
+    self->elements = temp;
+    self->capacity = capacity;
+    self->stats.reallocations++;
+#ifdef __GLIBC__
+    if (self->growth.round_to_allocator) {
+        // Claim the slack of the allocator size class, calloc only zeroed what was asked for.
+        self->capacity = malloc_usable_size(temp) / self->elements_size;
+        if (self->flags & VECTOR_ZERO_PAGES) {
+            memset(self->elements + capacity * self->elements_size, 0, (self->capacity - capacity) * self->elements_size);
+        }
+    }
+#endif
+    if (!(self->flags & VECTOR_ZERO_PAGES)) {
+        vector_zero(self, old_capacity, self->capacity - old_capacity);
+    }
+    return true;
+}
+/*
+ * Capacity a growth policy picks for at least required elements, or
+ * required itself when the policy result would overflow.
+ */
+static size_t vector_growth_next(const vector_growth_t* const growth, const size_t required) {
+    size_t capacity = required;
+    switch (growth->kind) {
+        case VECTOR_GROWTH_GEOMETRIC:
+            if (required <= SIZE_MAX / growth->numerator) {
+                capacity = required * growth->numerator / growth->denominator;
+            }
+            break;
+        case VECTOR_GROWTH_POWER_OF_TWO:
+            capacity = 1;
+            while (capacity < required && capacity <= SIZE_MAX / 2) {
+                capacity <<= 1;
+            }
+            break;
+        case VECTOR_GROWTH_FIXED:
+            if (required <= SIZE_MAX - growth->increment) {
+                capacity = (required + growth->increment - 1) / growth->increment * growth->increment;
+            }
+            break;
+    }
+    return capacity > required ? capacity : required;
+}
+/*
+ * Open element_count slots at index, shifting the tail up, and return the
+ * first one. Slots content is left unspecified for the caller to overwrite.
+ */
+static void* vector_open_gap(vector_t* const self, const size_t element_count, const size_t index) {
+    if (element_count > SIZE_MAX - self->size) {
+        return NULL;
+    }
+    if (self->size + element_count > self->capacity || !self->elements) {
+        vector_reserve(self, self->size + element_count);
+        if (!self->elements || self->size + element_count > self->capacity) {
+            return NULL;
+        }
+    }
+    else if (!vector_writable(self)) {
+        return NULL;
+    }
+    void* const gap = self->elements + index * self->elements_size;
+    if (index < self->size) {
+        memmove(gap + element_count * self->elements_size, gap, (self->size - index) * self->elements_size);
+    }
+    self->size += element_count;
+    return gap;
+}
+/*
+ * vector_push_back when the buffer is full, shared or not allocated yet.
+ * Kept out of line so the common path needs no stack frame.
+ */
+_COLD_ static void vector_push_back_grow(vector_t* const self, const void* const element) {
+    void* const slot = vector_open_gap(self, 1, self->size);
+    if (slot) {
+        self->kernel->copy(slot, element, 1, self->elements_size);
+    }
+}
 ///////////
 // Basic //
 ///////////
@@ -69,7 +475,23 @@ static bool vector_status(vector_t* const self){
  * @return A new vector container.
  */
 vector_t* vector_init(const size_t elements_size, const size_t elements_count) {
-    if (!elements_size) {
+    return vector_init_flags(elements_size, elements_count, VECTOR_DEFAULT);
+}
+/**
+ * @brief Initialize a new vector container choosing how spare capacity is filled.
+ *
+ * @param elements_size What kind of variables is going to hold the vector container.
+ * @param elements_count How much capacity the vector container will have at it's creation.
+ * @param flags VECTOR_DEFAULT zeroes capacity eagerly, VECTOR_UNINITIALIZED never
+ *              zeroes it and VECTOR_ZERO_PAGES takes it zeroed from calloc so pages
+ *              are only committed once written. VECTOR_MMAP backs the vector
+ *              with anonymous mappings grown by mremap, optionally using
+ *              transparent huge pages with VECTOR_HUGEPAGES.
+ *
+ * @return A new vector container.
+ */
+vector_t* vector_init_flags(const size_t elements_size, const size_t elements_count, const uint32_t flags) {
+    if (!elements_size || (flags & VECTOR_UNINITIALIZED && flags & VECTOR_ZERO_PAGES) || (flags & VECTOR_HUGEPAGES && !(flags & VECTOR_MMAP))) {
         return NULL;
     }
     vector_t* init = malloc(sizeof(vector_t));
@@ -77,24 +499,137 @@ vector_t* vector_init(const size_t elements_size, const size_t elements_count) {
         return NULL;
     }
     init->size = 0;
+    init->capacity = 0;
     init->elements_size = elements_size;
-    if (!elements_count) {
-        init->capacity = elements_count;
-        init->elements = NULL;
+    init->elements = NULL;
+    init->kernel = vector_kernel_select(elements_size);
+    init->flags = flags;
+    init->mapped = 0;
+    init->growth = _DEFAULT_GROWTH_;
+    init->stats.reallocations = 0;
+    init->stats.bytes_moved = 0;
+    init->fd = -1;
+    init->shared = NULL;
+    init->inline_capacity = 0;
+    if (elements_count && !vector_grow(init, vector_grow_capacity(elements_count))) {
+        free(init);
+        return NULL;
     }
-    else {
-        init->capacity = (size_t)(elements_count * _GROWTH_FACTOR_);
-        init->elements = malloc(init->elements_size * vector_capacity(init));
-        if (!init->elements) {
-            free(init);
-            return NULL;
-        }
-        for (size_t i = 0; i < init->capacity; ++i) {
-            memory_set(init->elements + i * init->elements_size, 0, init->elements_size);
-        }
+    return init;
+}
+/**
+ * @brief Initialize a new vector container with a small buffer.
+ *
+ * The first inline_count elements live in the same allocation as the
+ * container, so small vectors cost one malloc. Growing past them moves the
+ * elements to the heap, shrink_to_fit moves them back once they fit again.
+ *
+ * @param elements_size What kind of variables is going to hold the vector container.
+ * @param inline_count How many elements fit in the small buffer.
+ * @param flags Same as vector_init_flags, except VECTOR_MMAP and VECTOR_HUGEPAGES.
+ *
+ * @return A new vector container.
+ */
+vector_t* vector_init_small(const size_t elements_size, const size_t inline_count, const uint32_t flags) {
+    if (!elements_size || !inline_count || inline_count > (SIZE_MAX - sizeof(vector_t)) / elements_size ||
+        flags & (VECTOR_MMAP | VECTOR_HUGEPAGES) || (flags & VECTOR_UNINITIALIZED && flags & VECTOR_ZERO_PAGES)) {
+        return NULL;
+    }
+    vector_t* init = malloc(sizeof(vector_t) + inline_count * elements_size);
+    if (!init) {
+        return NULL;
+    }
+    init->size = 0;
+    init->capacity = inline_count;
+    init->elements_size = elements_size;
+    init->elements = init->inline_elements;
+    init->kernel = vector_kernel_select(elements_size);
+    init->flags = flags;
+    init->mapped = 0;
+    init->growth = _DEFAULT_GROWTH_;
+    init->stats.reallocations = 0;
+    init->stats.bytes_moved = 0;
+    init->fd = -1;
+    init->shared = NULL;
+    init->inline_capacity = inline_count;
+    vector_zero(init, 0, inline_count);
+    return init;
+}
+/**
+ * @brief Open a vector container stored in a memory-mapped file.
+ *
+ * The file starts with a header holding the elements size, size and
+ * capacity, followed by the elements. A missing or empty file becomes an
+ * empty vector. The mapping is shared, so other processes mapping the same
+ * file see the same pages. Growth extends the file with ftruncate and
+ * remaps it, vector_sync flushes it and vector_destroy closes it.
+ *
+ * @param path Path of the file backing the vector container.
+ * @param elements_size What kind of variables is going to hold the vector container.
+ *
+ * @return A new vector container, or NULL if the file holds another element size or is damaged.
+ */
+vector_t* vector_open_file(const char* const path, const size_t elements_size) {
+    if (!path || !elements_size) {
+        return NULL;
+    }
+    const int fd = open(path, O_RDWR | O_CREAT, 0644);
+    if (fd < 0) {
+        return NULL;
+    }
+    struct stat info;
+    vector_file_header header = { { 0 }, elements_size, 0, 0 };
+    memcpy(header.magic, _FILE_MAGIC_, sizeof(header.magic));
+    bool valid = !fstat(fd, &info);
+    if (valid && info.st_size) {
+        valid = (size_t)info.st_size >= _FILE_HEADER_ && pread(fd, &header, sizeof(header), 0) == sizeof(header) &&
+                !memcmp(header.magic, _FILE_MAGIC_, sizeof(header.magic)) && header.elements_size == elements_size &&
+                header.size <= header.capacity && header.capacity <= ((size_t)info.st_size - _FILE_HEADER_) / elements_size;
+    }
+    else if (valid) {
+        valid = !ftruncate(fd, _FILE_HEADER_) && pwrite(fd, &header, sizeof(header), 0) == sizeof(header);
+    }
+    vector_t* init = valid ? malloc(sizeof(vector_t)) : NULL;
+    if (!init) {
+        close(fd);
+        return NULL;
+    }
+    const size_t bytes = _FILE_HEADER_ + header.capacity * elements_size;
+    void* base = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (base == MAP_FAILED) {
+        free(init);
+        close(fd);
+        return NULL;
     }
+    init->size = header.size;
+    init->capacity = header.capacity;
+    init->elements_size = elements_size;
+    init->elements = (uint8_t*)base + _FILE_HEADER_;
+    init->kernel = vector_kernel_select(elements_size);
+    init->flags = _VECTOR_FILE_;
+    init->mapped = bytes;
+    init->growth = _DEFAULT_GROWTH_;
+    init->stats.reallocations = 0;
+    init->stats.bytes_moved = 0;
+    init->fd = fd;
+    init->shared = NULL;
+    init->inline_capacity = 0;
     return init;
 }
+/**
+ * @brief Flush a file-backed vector container to its file.
+ *
+ * @param self File-backed vector container to flush.
+ *
+ * @return Return true once the header and every element reached the file.
+ */
+bool vector_sync(vector_t* const self) {
+    if (!vector_status(self) || !(self->flags & _VECTOR_FILE_)) {
+        return false;
+    }
+    vector_file_header_of(self)->size = self->size;
+    return !msync(vector_file_header_of(self), self->mapped, MS_SYNC);
+}
 /**
  * @brief Free the memory of a vector content plus container itself.
  *
@@ -104,13 +639,8 @@ void vector_destroy(vector_t* const self) {
     if (!self) {
         return;
     }
-    if (!self->elements) {
-        free(self);
-    }
-    else {
-        free(self->elements);
-        free(self);
-    }
+    vector_release(self);
+    free(self);
 }
 ////////////
 // Access //
@@ -124,7 +654,7 @@ void vector_destroy(vector_t* const self) {
  * @return Return a element from self at index.
  */
 void* vector_at(vector_t* const self, const size_t index) {
-    if (!vector_status(self)) {
+    if (!vector_status(self) || !vector_writable(self)) {
         return NULL;
     }
     return self->elements + index * self->elements_size;
@@ -137,11 +667,26 @@ void* vector_at(vector_t* const self, const size_t index) {
  * @return Return the last element in self.
  */
 void* vector_back(vector_t* const self) {
-    if (!vector_status(self)) {
+    if (!vector_status(self) || !vector_writable(self)) {
         return NULL;
     }
     return self->size ? self->elements + (vector_size(self) - 1) * self->elements_size : vector_data(self);
 }
+/**
+ * @brief Return the content in a vector container for reading only.
+ *
+ * Unlike vector_data, it never gives self a private copy of a buffer shared by vector_copy.
+ *
+ * @param self Vector container to get content from.
+ *
+ * @return Return a pointer to const void with self content.
+ */
+const void* vector_cdata(vector_t* const self) {
+    if (!vector_status(self)) {
+        return NULL;
+    }
+    return self->elements;
+}
 /**
  * @brief Return the content in a vector container.
  *
@@ -150,7 +695,7 @@ void* vector_back(vector_t* const self) {
  * @return Return a pointer to void with self content.
  */
 void* vector_data(vector_t* const self) {
-    if (!vector_status(self)) {
+    if (!vector_status(self) || !vector_writable(self)) {
         return NULL;
     }
     return self->elements;
@@ -163,11 +708,27 @@ void* vector_data(vector_t* const self) {
  * @return Return the first element in self.
  */
 void* vector_front(vector_t* const self) {
-    if (!vector_status(self)) {
+    if (!vector_status(self) || !vector_writable(self)) {
         return NULL;
     }
     return self->elements;
 }
+/**
+ * @brief Return a element of a vector container for reading only.
+ *
+ * Unlike vector_at, it never gives self a private copy of a buffer shared by vector_copy.
+ *
+ * @param self  Vector container to get element from.
+ * @param index Position of the element. Start point is 0.
+ *
+ * @return Return the element at index, or NULL if index is out of range.
+ */
+const void* vector_get(vector_t* const self, const size_t index) {
+    if (!vector_status(self) || index >= self->size) {
+        return NULL;
+    }
+    return self->elements + index * self->elements_size;
+}
 /**
  * @brief Copy a vector container content to a pointer to void.
  *
@@ -179,9 +740,7 @@ void vector_to_array(vector_t* const self, void* const array, const size_t array
     if (!vector_status(self) || !array_size) {
         return;
     }
-    for (size_t i = 0; i < array_size; ++i) {
-        memory_copy(array + i * self->elements_size, self->elements + i * self->elements_size, array_size);
-    }
+    self->kernel->copy(array, self->elements, array_size < self->size ? array_size : self->size, self->elements_size);
 }
 //////////////
 // Capacity //
@@ -192,6 +751,63 @@ size_t vector_capacity(vector_t* const self) {
     }
     return self->capacity;
 }
+/**
+ * @brief Returns the capacity a vector grows to when it needs room for size elements.
+ *
+ * Exposed so the typed vectors of vector_typed.h share the growth policy.
+ *
+ * @param size Elements the vector must be able to hold.
+ *
+ * @return Return a capacity not lower than size.
+ */
+size_t vector_grow_capacity(const size_t size) {
+    return vector_growth_next(&_DEFAULT_GROWTH_, size);
+}
+/**
+ * @brief Select how a vector container picks its capacity when it grows.
+ *
+ * @param self      Vector container whose growth policy will change.
+ * @param growth    Geometric needs numerator > denominator > 0, fixed needs an increment.
+ *                  round_to_allocator also claims the allocator size class slack
+ *                  (malloc_usable_size, or whole pages for VECTOR_MMAP).
+ */
+void vector_set_growth(vector_t* const self, const vector_growth_t* const growth) {
+    if (!self || !growth) {
+        return;
+    }
+    if ((growth->kind == VECTOR_GROWTH_GEOMETRIC && (!growth->denominator || growth->numerator <= growth->denominator)) ||
+        (growth->kind == VECTOR_GROWTH_FIXED && !growth->increment)) {
+        return;
+    }
+    self->growth = *growth;
+}
+/**
+ * @brief Returns reallocation counters of a vector container.
+ *
+ * @param self Vector container to retrieve counters from.
+ *
+ * @return Return how many times self storage was reallocated and how many bytes had to be copied.
+ */
+vector_stats_t vector_stats(vector_t* const self) {
+    if (!self) {
+        const vector_stats_t empty = { 0, 0 };
+        return empty;
+    }
+    return self->stats;
+}
+/**
+ * @brief Returns the size in bytes of each element in a vector container.
+ *
+ * @param self Vector container to retrieve elements size from.
+ *
+ * @return Return the elements size of self.
+ */
+size_t vector_elements_size(vector_t* const self) {
+    if (!self) {
+        return 0;
+    }
+    return self->elements_size;
+}
 /**
  * @brief Returns if a vector container has any elements at all.
  *
@@ -212,16 +828,8 @@ void vector_reserve(vector_t* const self, const size_t size) {
     if (!self || !size) {
         return;
     }
-    if (self->capacity < size) {
-        self->capacity = (size_t)(size * _GROWTH_FACTOR_);
-        void* temp = realloc(self->elements, self->elements_size * self->capacity);
-        if (!temp) {
-            return;
-        }
-        self->elements = temp;
-        for (size_t i = self->capacity - self->size - 1; i < self->capacity; ++i) {
-            memory_set(self->elements + i * self->elements_size, 0, self->elements_size);
-        }
+    if (self->capacity < size || !self->elements) {
+        vector_grow(self, vector_growth_next(&self->growth, size));
     }
 }
 /**
@@ -231,24 +839,28 @@ void vector_reserve(vector_t* const self, const size_t size) {
  * @param size New size that will be use in a vector container.
  */
 void vector_resize(vector_t *const self, const size_t size, void* const element) {
-    if (!vector_status(self) || !size) {
+    if (!vector_status(self) || !size || !vector_writable(self)) {
         return;
     }
     if (size > self->size) {
         if (size > self->capacity) {
             vector_reserve(self, size);
-        }
-        for (size_t i = self->size; i < size; i++) {
-            if (!element) {
-                memory_set(self->elements + i * self->elements_size, 0, self->elements_size);
+            if (size > self->capacity) {
+                return;
             }
-            else {
-                memory_copy(self->elements + i * self->elements_size, element, self->elements_size);
+        }
+        if (!element) {
+            // Spare capacity is already zero unless the vector opted out of it.
+            if (self->flags & VECTOR_UNINITIALIZED) {
+                memset(self->elements + self->size * self->elements_size, 0, (size - self->size) * self->elements_size);
             }
         }
+        else {
+            self->kernel->fill(self->elements + self->size * self->elements_size, element, size - self->size, self->elements_size);
+        }
     }
     else {
-        vector_erase(self, self->size - 1, size - 1);
+        vector_erase(self, size, self->size - 1);
     }
     self->size = size;
 }
@@ -258,17 +870,42 @@ void vector_resize(vector_t *const self, const size_t size, void* const element)
  * @param self Vector container to shrink capacity.
  */
 void vector_shrink_to_fit(vector_t* const self) {
-    if (!vector_status(self)) {
+    if (!vector_status(self) || self->capacity <= self->size || !vector_writable(self)) {
         return;
     }
-    if (self->capacity > self->size) {
-        self->capacity = self->size;
-        void* temp = realloc(self->elements, self->capacity * self->elements_size);
-        if (!temp) {
-            return;
+    if (self->flags & _VECTOR_FILE_) {
+        vector_remap_file(self, self->size);
+        return;
+    }
+    if (self->flags & VECTOR_MMAP) {
+        // Hand whole tail pages back to the kernel but keep the address range.
+        const size_t keep = vector_page_round(self->size * self->elements_size);
+        if (keep < self->mapped) {
+            madvise(self->elements + keep, self->mapped - keep, MADV_DONTNEED);
         }
-        self->elements = temp;
+        self->capacity = self->size;
+        return;
+    }
+    if (vector_is_inline(self)) {
+        return;
+    }
+    if (self->inline_capacity && self->size <= self->inline_capacity) {
+        self->kernel->copy(self->inline_elements, self->elements, self->size, self->elements_size);
+        free(self->elements);
+        self->elements = self->inline_elements;
+        self->capacity = self->inline_capacity;
+        vector_zero(self, self->size, self->capacity - self->size);
+        return;
     }
+    if (!self->size) {
+        return;
+    }
+    void* temp = realloc(self->elements, self->size * self->elements_size);
+    if (!temp) {
+        return;
+    }
+    self->elements = temp;
+    self->capacity = self->size;
 }
 /**
  * @brief Returns the current size of a vector container.
@@ -286,6 +923,23 @@ size_t vector_size(vector_t* const self) {
 /////////////////
 // Operations //
 ////////////////
+/**
+ * @brief Append a block of elements at vector container end.
+ *
+ * @param self          Vector container that will hold the new elements.
+ * @param elements      Pointer to the first of element_count contiguous elements.
+ * @param element_size  Size of each element, must match the vector elements size.
+ * @param element_count How many elements will be appended.
+ */
+void vector_append_n(vector_t* const self, const void* const elements, const size_t element_size, const size_t element_count) {
+    if (!self || !elements || element_size != self->elements_size || !element_count) {
+        return;
+    }
+    void* const slots = vector_open_gap(self, element_count, self->size);
+    if (slots) {
+        self->kernel->copy(slots, elements, element_count, self->elements_size);
+    }
+}
 /**
  * @brief Assign a new content to a vector.
  *
@@ -295,14 +949,21 @@ size_t vector_size(vector_t* const self) {
  * @param element_count How many elements will be inserted.
  */
 void vector_assign(vector_t* const self, void* const element, const size_t element_size, const size_t element_count) {
-    if (!element || element_size != self->elements_size || !element_count) {
+    if (!self || !element || element_size != self->elements_size || !element_count) {
+        return;
+    }
+    if (self->shared && self->capacity >= element_count && !vector_writable(self)) {
         return;
     }
-    if (element_count > vector_capacity(self)) {
+    if (element_count > self->capacity || !self->elements) {
         vector_reserve(self, element_count);
+        if (!self->elements || element_count > self->capacity) {
+            return;
+        }
     }
-    for (size_t i = 0; i < element_count; ++i) {
-        memory_copy(self->elements + i * self->elements_size, element, self->elements_size);
+    self->kernel->fill(self->elements, element, element_count, self->elements_size);
+    if (element_count < self->size) {
+        vector_zero(self, element_count, self->size - element_count);
     }
     self->size = element_count;
 }
@@ -315,14 +976,59 @@ void vector_clear(vector_t* const self) {
     if (!self) {
         return;
     }
-    for (size_t i = 0; i < self->size; ++i) {
-        memory_set(self->elements + i * self->elements_size, 0, self->elements_size);
+    if (self->shared) {
+        // Nothing to keep, so let go of the shared buffer instead of copying it.
+        vector_release(self);
+    }
+    else if (self->elements) {
+        vector_zero(self, 0, self->size);
     }
     self->size = 0;
 }
+/*
+ * Let dst reference the heap buffer of src. Mapped, file-backed and small
+ * buffers are never shared, neither are buffers whose spare capacity dst
+ * would expect zeroed while src does not.
+ */
+static bool vector_share(vector_t* const dst, vector_t* const src) {
+    const uint32_t unshareable = _VECTOR_FILE_ | VECTOR_MMAP;
+    if (src->flags & unshareable || dst->flags & unshareable || vector_is_inline(src) || dst->elements_size != src->elements_size ||
+        (src->flags & VECTOR_UNINITIALIZED && !(dst->flags & VECTOR_UNINITIALIZED))) {
+        return false;
+    }
+    vector_shared* shared = atomic_load_explicit(&src->shared, memory_order_acquire);
+    if (!shared) {
+        // Concurrent copies of the same src race to install its reference count.
+        vector_shared* fresh = malloc(sizeof(vector_shared));
+        if (!fresh) {
+            return false;
+        }
+        atomic_init(&fresh->references, 1);
+        if (atomic_compare_exchange_strong_explicit(&src->shared, &shared, fresh, memory_order_acq_rel, memory_order_acquire)) {
+            shared = fresh;
+        }
+        else {
+            free(fresh);
+        }
+    }
+    atomic_fetch_add_explicit(&shared->references, 1, memory_order_relaxed);
+    vector_release(dst);
+    dst->elements = src->elements;
+    dst->capacity = src->capacity;
+    dst->size = src->size;
+    dst->shared = shared;
+    return true;
+}
 /**
  * @brief Copy the content from a vector container to another one.
  *
+ * Heap buffers are shared rather than copied: both vectors reference the same
+ * elements until one of them is mutated, which then takes a private copy.
+ * Accessors returning writable pointers count as mutations, read through
+ * vector_get and vector_cdata to keep sharing. Reference counts are atomic, so
+ * copies may be handed to other threads and several threads may copy the same
+ * src at once, as long as none of them mutates it meanwhile.
+ *
  * @param dst Vector container that will recieve the copied elements.
  * @param src Vector container whose elements will be copied.
  * 
@@ -333,43 +1039,121 @@ vector_t* vector_copy(vector_t* dst, vector_t* const src) {
         return NULL;
     }
     if (!dst) {
-        dst = vector_init(src->elements_size, src->size);
-    }
-    else {
-        vector_clear(dst);
+        dst = vector_init(src->elements_size, 0);
+        if (!dst) {
+            return NULL;
+        }
     }
-    for (size_t i = 0; i < src->size; ++i) {
-        vector_push_back(dst, src->elements + i * src->elements_size, src->elements_size);
+    if (dst == src || vector_share(dst, src)) {
+        return dst;
     }
+    vector_clear(dst);
+    vector_append_n(dst, src->elements, src->elements_size, src->size);
     return dst;
 }
+/**
+ * @brief Open a slot at random position into a vector container, for the caller to construct a element in place.
+ *
+ * @param self  Vector container which the insertion will occur.
+ * @param index Position of the new slot. Equal to size appends.
+ *
+ * @return Return the new slot, whose content is unspecified, or NULL on failure.
+ *         It stays valid until the next operation that may grow the vector.
+ */
+void* vector_emplace_at(vector_t* const self, const size_t index) {
+    if (!self || index > self->size) {
+        return NULL;
+    }
+    return vector_open_gap(self, 1, index);
+}
+/**
+ * @brief Open a slot at vector container end, for the caller to construct a element in place.
+ *
+ * @param self Vector container that will hold the new element.
+ *
+ * @return Return the new slot, whose content is unspecified, or NULL on failure.
+ *         It stays valid until the next operation that may grow the vector.
+ */
+void* vector_emplace_back(vector_t* const self) {
+    return vector_grow_by(self, 1);
+}
 /**
  * @brief Remove a element amount from a vector container.
  *
+ * Only the elements after the erased range are shifted, in place.
+ *
  * @param self Vector container whose elements will be erased.
  * @param start Start position from which will the erase begin.
- * @param end End position at which the erase will stop.
+ * @param end End position at which the erase will stop, inclusive.
  */
 void vector_erase(vector_t* const self, const size_t start, const size_t end) {
-    if (!vector_status(self) || start >= self->size || !end) {
+    if (!vector_status(self) || start >= self->size || end < start || !vector_writable(self)) {
         return;
     }
-    const size_t elements_size = self->size;
-    void* elements = malloc(elements_size * self->elements_size);
-    for (size_t i = 0; i < elements_size; ++i) {
-        memory_copy(elements + i * self->elements_size, self->elements + i * self->elements_size, self->elements_size);
+    const size_t last = end < self->size ? end : self->size - 1;
+    const size_t erased = last - start + 1;
+    memmove(self->elements + start * self->elements_size, self->elements + (last + 1) * self->elements_size, (self->size - last - 1) * self->elements_size);
+    self->size -= erased;
+    vector_zero(self, self->size, erased);
+}
+/**
+ * @brief Remove every element matching a predicate from a vector container.
+ *
+ * Kept elements preserve their relative order and are moved in runs during a
+ * single pass over the vector.
+ *
+ * @param self      Vector container whose elements will be erased.
+ * @param predicate Function returning true for elements to be removed.
+ * @param context   Pointer handed unchanged to every predicate call.
+ *
+ * @return Return how many elements were removed from self.
+ */
+size_t vector_erase_if(vector_t* const self, bool (*predicate)(const void* const element, void* const context), void* const context) {
+    if (!vector_status(self) || !predicate || !vector_writable(self)) {
+        return 0;
+    }
+    size_t write = 0;
+    size_t run_start = 0;
+    size_t run_length = 0;
+    for (size_t i = 0; i < self->size; ++i) {
+        if (!predicate(self->elements + i * self->elements_size, context)) {
+            if (!run_length) {
+                run_start = i;
+            }
+            ++run_length;
+            continue;
+        }
+        if (run_length) {
+            if (write != run_start) {
+                memmove(self->elements + write * self->elements_size, self->elements + run_start * self->elements_size, run_length * self->elements_size);
+            }
+            write += run_length;
+            run_length = 0;
+        }
     }
-    vector_clear(self);
-    size_t i = 0;
-    size_t self_it = 0;
-    for (; i < start; ++i) {
-        memory_copy(self->elements + self_it++ * self->elements_size, elements + i * self->elements_size, self->elements_size);
+    if (run_length && write != run_start) {
+        memmove(self->elements + write * self->elements_size, self->elements + run_start * self->elements_size, run_length * self->elements_size);
     }
-    for (i = end + 1; i < elements_size; ++i) {
-        memory_copy(self->elements + self_it++ * self->elements_size, elements + i * self->elements_size, self->elements_size);
+    write += run_length;
+    const size_t removed = self->size - write;
+    vector_zero(self, write, removed);
+    self->size = write;
+    return removed;
+}
+/**
+ * @brief Append element_count slots at vector container end, for the caller to fill in place.
+ *
+ * @param self          Vector container that will hold the new elements.
+ * @param element_count How many slots will be appended.
+ *
+ * @return Return the first of element_count contiguous slots, whose content is unspecified,
+ *         or NULL on failure. They stay valid until the next operation that may grow the vector.
+ */
+void* vector_grow_by(vector_t* const self, const size_t element_count) {
+    if (!self || !element_count) {
+        return NULL;
     }
-    self->size = end - start + 1;
-    free(elements);
+    return vector_open_gap(self, element_count, self->size);
 }
 /**
  * @brief Insert a element at random position into a vector container.
@@ -383,16 +1167,25 @@ void vector_insert(vector_t* const self, void* const element, const size_t eleme
     if (!self || !element || !element_size || element_size != self->elements_size || index >= self->size) {
         return;
     }
-    if (self->size + 1 > self->capacity) {
-        vector_reserve(self, self->capacity + 1);
+    vector_insert_n(self, element, element_size, 1, index);
+}
+/**
+ * @brief Insert a block of elements at random position into a vector container.
+ *
+ * @param self          Vector container which the insertion will occur.
+ * @param elements      Pointer to the first of element_count contiguous elements.
+ * @param element_size  Size of each element, must match the vector elements size.
+ * @param element_count How many elements will be inserted.
+ * @param index         Position at which the first element will be inserted. Equal to size appends.
+ */
+void vector_insert_n(vector_t* const self, const void* const elements, const size_t element_size, const size_t element_count, const size_t index) {
+    if (!self || !elements || element_size != self->elements_size || !element_count || index > self->size) {
+        return;
     }
-    for (size_t i = self->size; i > index; --i) {
-        memory_copy(self->elements + i * self->elements_size, self->elements + (i - 1) * self->elements_size, self->elements_size);
-        if (i - 1 == index) {
-            memory_copy(self->elements + index * self->elements_size, element, self->elements_size);
-        }
+    void* const slots = vector_open_gap(self, element_count, index);
+    if (slots) {
+        self->kernel->copy(slots, elements, element_count, self->elements_size);
     }
-    self->size++;
 }
 /**
  * @brief Move the content from a vector container to another one.
@@ -416,10 +1209,10 @@ vector_t* vector_move(vector_t* dst, vector_t* src) {
  * @param self Vector container whose last element will be removed.
  */
 void vector_pop_back(vector_t* const self) {
-    if (!vector_status(self) || !self->size) {
+    if (!vector_status(self) || !self->size || !vector_writable(self)) {
         return;
     }
-    memory_set(self->elements + (self->size - 1) * self->elements_size, 0, self->elements_size);
+    vector_zero(self, self->size - 1, 1);
     self->size--;
 }
 /**
@@ -432,25 +1225,28 @@ void vector_push_back(vector_t* const self, const void* const element, const siz
     if (!self || !element || element_size != self->elements_size) {
         return;
     }
-    if (!self->elements) {
-        if (self->size + 1 >= self->capacity) {
-            self->capacity = (size_t)((self->capacity + 1) * _GROWTH_FACTOR_);
-        }
-        self->elements = malloc(self->elements_size * self->capacity);
-        if (!self->elements) {
+    // Common case: room left in a private buffer. Fixed sizes copy inline,
+    // with no call through the kernel table. Bytes and half words are stored
+    // ahead of the switch, so they skip its jump table.
+    if (self->size < self->capacity && self->elements && !atomic_load_explicit(&self->shared, memory_order_relaxed)) {
+        uint8_t* const slot = (uint8_t*)self->elements + self->size++ * element_size;
+        if (element_size == 1) {
+            *slot = *(const uint8_t*)element;
             return;
         }
-        for (size_t index = self->capacity - self->size - 1; index < self->capacity; ++index) {
-            memory_set(self->elements + index * self->elements_size, 0, self->elements_size);
+        if (element_size == 2) {
+            memcpy(slot, element, 2);
+            return;
         }
-    }
-    else {
-        if (self->size + 1 >= self->capacity) {
-            vector_reserve(self, self->capacity + 1);
+        switch (element_size) {
+            case 4:  memcpy(slot, element, 4);  break;
+            case 8:  memcpy(slot, element, 8);  break;
+            case 16: memcpy(slot, element, 16); break;
+            default: memcpy(slot, element, element_size); break;
         }
+        return;
     }
-    memory_copy(self->elements + self->size * self->elements_size, element, self->elements_size);
-    self->size++;
+    vector_push_back_grow(self, element);
 }
 /**
  * @brief Swap the content of two stack containers.
@@ -462,7 +1258,14 @@ void vector_swap(vector_t* const dst, vector_t* const src) {
     if (!vector_status(dst) || !vector_status(src)) {
         return;
     }
+    // Small buffers belong to their container, so move them out before trading storage.
+    if ((vector_is_inline(dst) && !vector_grow(dst, dst->capacity)) ||
+        (vector_is_inline(src) && !vector_grow(src, src->capacity))) {
+        return;
+    }
     vector_t temp = *dst;
     *dst = *src;
     *src = temp;
+    src->inline_capacity = dst->inline_capacity;
+    dst->inline_capacity = temp.inline_capacity;
 }
@@ -29,23 +29,70 @@ SOFTWARE.
 #include <stdint.h>
 
 typedef struct _internal_vector vector_t;
+
+/*
+ * Growth policy, see vector_set_growth.
+ */
+typedef enum vector_growth_kind {
+    VECTOR_GROWTH_GEOMETRIC,    // required * numerator / denominator.
+    VECTOR_GROWTH_POWER_OF_TWO, // Next power of two not below required.
+    VECTOR_GROWTH_FIXED         // required rounded up to a multiple of increment.
+} vector_growth_kind;
+
+typedef struct vector_growth {
+    vector_growth_kind kind;
+    size_t numerator;
+    size_t denominator;
+    size_t increment;
+    bool round_to_allocator;
+} vector_growth_t;
+
+#define VECTOR_GROWTH_DEFAULT { VECTOR_GROWTH_GEOMETRIC, 3, 2, 0, false }
+
+/*
+ * Growth telemetry, see vector_stats.
+ */
+typedef struct vector_stats {
+    size_t reallocations;
+    size_t bytes_moved;
+} vector_stats_t;
+
+/*
+ * vector_init_flags options.
+ */
+#define VECTOR_DEFAULT          0x0u // Spare capacity is zero filled eagerly.
+#define VECTOR_UNINITIALIZED    0x1u // Spare capacity is never zero filled.
+#define VECTOR_ZERO_PAGES       0x2u // Spare capacity comes zeroed from calloc, committed on first write.
+#define VECTOR_MMAP             0x4u // Storage is an anonymous mapping grown with mremap, no copying.
+#define VECTOR_HUGEPAGES        0x8u // With VECTOR_MMAP, advise transparent huge pages.
+
 ///////////
 // Basic //
 ///////////
 vector_t*   vector_init(const size_t elements_size, const size_t elements_count);
+vector_t*   vector_init_flags(const size_t elements_size, const size_t elements_count, const uint32_t flags);
+vector_t*   vector_init_small(const size_t elements_size, const size_t inline_count, const uint32_t flags);
+vector_t*   vector_open_file(const char* const path, const size_t elements_size);
+bool        vector_sync(vector_t* const self);
 void        vector_destroy(vector_t* const self);
 ////////////
 // Access //
 ////////////
 void*       vector_at(vector_t* const self, const size_t index);
 void*       vector_back(vector_t* const self);
+const void* vector_cdata(vector_t* const self);
 void*       vector_data(vector_t* const self);
 void*       vector_front(vector_t* const self);
+const void* vector_get(vector_t* const self, const size_t index);
 void        vector_to_array(vector_t* const self, void* const array, const size_t array_size);
 //////////////
 // Capacity //
 //////////////
 size_t      vector_capacity(vector_t* const self);
+size_t      vector_elements_size(vector_t* const self);
+size_t      vector_grow_capacity(const size_t size);
+void        vector_set_growth(vector_t* const self, const vector_growth_t* const growth);
+vector_stats_t vector_stats(vector_t* const self);
 bool        vector_is_empty(vector_t* const self);
 void        vector_reserve(vector_t* const self, const size_t size);
 void        vector_resize(vector_t* const self, const size_t size, void* const element);
@@ -54,11 +101,17 @@ size_t      vector_size(vector_t* const self);
 /////////////////
 // Operations //
 ////////////////
+void        vector_append_n(vector_t* const self, const void* const elements, const size_t element_size, const size_t element_count);
 void        vector_assign(vector_t* const self, void* const element, const size_t element_size, const size_t element_count);
 void        vector_clear(vector_t* const self);
 vector_t*   vector_copy(vector_t* dst, vector_t* const src);
+void*       vector_emplace_at(vector_t* const self, const size_t index);
+void*       vector_emplace_back(vector_t* const self);
 void        vector_erase(vector_t* const self, const size_t start, const size_t end);
+size_t      vector_erase_if(vector_t* const self, bool (*predicate)(const void* const element, void* const context), void* const context);
+void*       vector_grow_by(vector_t* const self, const size_t element_count);
 void        vector_insert(vector_t* const self, void* const element, const size_t element_size, const size_t index);
+void        vector_insert_n(vector_t* const self, const void* const elements, const size_t element_size, const size_t element_count, const size_t index);
 vector_t*   vector_move(vector_t* dst, vector_t* src);
 void        vector_pop_back(vector_t* const self);
 void        vector_push_back(vector_t* const self, const void* const element, const size_t element_size);
@@ -0,0 +1,307 @@
+/*
+MIT License
+
+Copyright (c) 2018 Joseph Ojeda
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <stdatomic.h>  // atomic_size_t, atomic_compare_exchange_weak
+#include <stdlib.h>     // malloc, free
+#include <string.h>     // memcpy
+
+#include "./vector_concurrent.h"
+
+#define _SEGMENTS_ 64
+#define _MIN_FIRST_SEGMENT_ 16
+
+/*
+ * Segment k holds first_segment << k elements, starting at element
+ * first_segment * (2^k - 1), followed by one written flag per element.
+ */
+struct _internal_vector_concurrent {
+    size_t elements_size;
+    size_t first_segment;
+    size_t first_shift;
+    _Alignas(64) atomic_size_t reserved;
+    _Alignas(64) atomic_size_t published;
+    _Alignas(64) _Atomic(uint8_t*) segments[_SEGMENTS_];
+};
+/*
+ * Check if a concurrent vector is not null.
+ */
+static bool vector_concurrent_status(vector_concurrent_t* const self) {
+    return self != NULL;
+}
+
+static size_t segment_of(const vector_concurrent_t* const self, const size_t index) {
+    const size_t block = (index >> self->first_shift) + 1;
+#if defined(__GNUC__)
+    return (size_t)(63 - __builtin_clzll((unsigned long long)block));
+#else
+    size_t segment = 0;
+    while (block >> (segment + 1)) {
+        ++segment;
+    }
+    return segment;
+#endif
+}
+
+static size_t segment_start(const vector_concurrent_t* const self, const size_t segment) {
+    return self->first_segment * (((size_t)1 << segment) - 1);
+}
+
+static uint8_t* vector_concurrent_slot(vector_concurrent_t* const self, const size_t index) {
+    const size_t segment = segment_of(self, index);
+    uint8_t* const base = atomic_load_explicit(&self->segments[segment], memory_order_acquire);
+    return base + (index - segment_start(self, segment)) * self->elements_size;
+}
+
+static atomic_uchar* vector_concurrent_flag(vector_concurrent_t* const self, const size_t index) {
+    const size_t segment = segment_of(self, index);
+    uint8_t* const base = atomic_load_explicit(&self->segments[segment], memory_order_acquire);
+    return (atomic_uchar*)(base + (self->first_segment << segment) * self->elements_size) + (index - segment_start(self, segment));
+}
+/*
+ * Allocate every segment covering [first, first + count) that does not exist
+ * yet. Racing producers may both allocate a segment, the loser frees its copy.
+ */
+static bool vector_concurrent_ensure(vector_concurrent_t* const self, const size_t first, const size_t count) {
+    const size_t last = segment_of(self, first + count - 1);
+    for (size_t segment = segment_of(self, first); segment <= last; ++segment) {
+        if (atomic_load_explicit(&self->segments[segment], memory_order_acquire)) {
+            continue;
+        }
+        const size_t count = self->first_segment << segment;
+        uint8_t* fresh = malloc(count * self->elements_size + count * sizeof(atomic_uchar));
+        if (!fresh) {
+            return false;
+        }
+        atomic_uchar* const flags = (atomic_uchar*)(fresh + count * self->elements_size);
+        for (size_t i = 0; i < count; ++i) {
+            atomic_init(&flags[i], 0);
+        }
+        uint8_t* expected = NULL;
+        if (!atomic_compare_exchange_strong_explicit(&self->segments[segment], &expected, fresh, memory_order_acq_rel, memory_order_acquire)) {
+            free(fresh);
+        }
+    }
+    return true;
+}
+/*
+ * Claim element_count slots: storage is secured first, then the range is
+ * taken with a compare-and-swap, so a failed allocation never leaves a
+ * claimed hole that would block publication.
+ */
+static size_t vector_concurrent_reserve(vector_concurrent_t* const self, const size_t element_count) {
+    size_t first = atomic_load_explicit(&self->reserved, memory_order_relaxed);
+    do {
+        if (first > SIZE_MAX - element_count || segment_of(self, first + element_count - 1) >= _SEGMENTS_ ||
+            !vector_concurrent_ensure(self, first, element_count)) {
+            return SIZE_MAX;
+        }
+    } while (!atomic_compare_exchange_weak_explicit(&self->reserved, &first, first + element_count, memory_order_release, memory_order_relaxed));
+    return first;
+}
+/*
+ * Mark [first, first + count) as written, then move the published size over
+ * every written element that follows it. Producers never wait on each other:
+ * whoever completes the range right after the published size carries it past
+ * every range finished out of order before.
+ */
+static void vector_concurrent_publish(vector_concurrent_t* const self, const size_t first, const size_t count) {
+    for (size_t i = first; i < first + count; ++i) {
+        atomic_store_explicit(vector_concurrent_flag(self, i), 1, memory_order_release);
+    }
+    // Two producers finishing adjacent ranges at once must not both miss the
+    // other's flags, or neither would publish past them. The fence orders the
+    // flag stores above before the scan below.
+    atomic_thread_fence(memory_order_seq_cst);
+    size_t published = atomic_load_explicit(&self->published, memory_order_acquire);
+    for (;;) {
+        const size_t reserved = atomic_load_explicit(&self->reserved, memory_order_acquire);
+        size_t end = published;
+        while (end < reserved && atomic_load_explicit(vector_concurrent_flag(self, end), memory_order_acquire)) {
+            ++end;
+        }
+        if (end == published) {
+            return;
+        }
+        if (atomic_compare_exchange_weak_explicit(&self->published, &published, end, memory_order_acq_rel, memory_order_acquire)) {
+            published = end;
+        }
+    }
+}
+///////////
+// Basic //
+///////////
+/**
+ * @brief Initialize a new concurrent append-only vector.
+ *
+ * @param elements_size         What kind of variables is going to hold the vector.
+ * @param first_segment_count   Elements in the first segment, rounded up to a power of two.
+ *
+ * @return A new concurrent vector.
+ */
+vector_concurrent_t* vector_concurrent_init(const size_t elements_size, const size_t first_segment_count) {
+    if (!elements_size) {
+        return NULL;
+    }
+    vector_concurrent_t* init = aligned_alloc(64, sizeof(vector_concurrent_t));
+    if (!init) {
+        return NULL;
+    }
+    init->elements_size = elements_size;
+    init->first_segment = _MIN_FIRST_SEGMENT_;
+    init->first_shift = 4;
+    while (init->first_segment < first_segment_count && init->first_shift < 32) {
+        init->first_segment <<= 1;
+        init->first_shift++;
+    }
+    atomic_init(&init->reserved, 0);
+    atomic_init(&init->published, 0);
+    for (size_t i = 0; i < _SEGMENTS_; ++i) {
+        atomic_init(&init->segments[i], NULL);
+    }
+    return init;
+}
+/**
+ * @brief Free every segment plus the vector itself. No other thread may use it anymore.
+ *
+ * @param self The concurrent vector to be freed.
+ */
+void vector_concurrent_destroy(vector_concurrent_t* const self) {
+    if (!vector_concurrent_status(self)) {
+        return;
+    }
+    for (size_t i = 0; i < _SEGMENTS_; ++i) {
+        free(atomic_load_explicit(&self->segments[i], memory_order_relaxed));
+    }
+    free(self);
+}
+////////////
+// Access //
+////////////
+/**
+ * @brief Returns a published element from a concurrent vector.
+ *
+ * @param self  Concurrent vector to get element from.
+ * @param index Position of the element. Start point is 0.
+ *
+ * @return Return the element at index, or NULL if it is not published yet.
+ */
+void* vector_concurrent_at(vector_concurrent_t* const self, const size_t index) {
+    if (!vector_concurrent_status(self) || index >= vector_concurrent_size(self)) {
+        return NULL;
+    }
+    return vector_concurrent_slot(self, index);
+}
+/**
+ * @brief Call a function on every element published when the call starts, in order.
+ *
+ * @param self      Concurrent vector whose elements will be visited.
+ * @param function  Function called once per element.
+ * @param context   Pointer handed unchanged to every function call.
+ */
+void vector_concurrent_for_each(vector_concurrent_t* const self, void (*function)(const void* const element, void* const context), void* const context) {
+    if (!vector_concurrent_status(self) || !function) {
+        return;
+    }
+    const size_t size = vector_concurrent_size(self);
+    size_t index = 0;
+    for (size_t segment = 0; index < size; ++segment) {
+        const uint8_t* const base = atomic_load_explicit(&self->segments[segment], memory_order_acquire);
+        const size_t end = segment_start(self, segment + 1) < size ? segment_start(self, segment + 1) : size;
+        for (; index < end; ++index) {
+            function(base + (index - segment_start(self, segment)) * self->elements_size, context);
+        }
+    }
+}
+//////////////
+// Capacity //
+//////////////
+/**
+ * @brief Returns if a concurrent vector has any published elements.
+ *
+ * @param self Concurrent vector to check size from.
+ *
+ * @return Return true if no element is published.
+ */
+bool vector_concurrent_is_empty(vector_concurrent_t* const self) {
+    return vector_concurrent_size(self) == 0;
+}
+/**
+ * @brief Returns how many elements of a concurrent vector are published.
+ *
+ * @param self Concurrent vector to retrieve size from.
+ *
+ * @return Return the published size of self. Every element below it is fully written.
+ */
+size_t vector_concurrent_size(vector_concurrent_t* const self) {
+    if (!vector_concurrent_status(self)) {
+        return 0;
+    }
+    return atomic_load_explicit(&self->published, memory_order_acquire);
+}
+/////////////////
+// Operations //
+////////////////
+/**
+ * @brief Append a block of elements at concurrent vector end, from any thread.
+ *
+ * @param self          Concurrent vector that will hold the new elements.
+ * @param elements      Pointer to the first of element_count contiguous elements.
+ * @param element_size  Size of each element, must match the vector elements size.
+ * @param element_count How many elements will be appended.
+ *
+ * @return Return the index of the first appended element, or SIZE_MAX on failure.
+ */
+size_t vector_concurrent_append_n(vector_concurrent_t* const self, const void* const elements, const size_t element_size, const size_t element_count) {
+    if (!vector_concurrent_status(self) || !elements || element_size != self->elements_size || !element_count) {
+        return SIZE_MAX;
+    }
+    const size_t first = vector_concurrent_reserve(self, element_count);
+    if (first == SIZE_MAX) {
+        return SIZE_MAX;
+    }
+    // Copy segment by segment, the range may straddle a boundary.
+    size_t index = first;
+    const uint8_t* source = elements;
+    while (index < first + element_count) {
+        const size_t segment = segment_of(self, index);
+        const size_t end = segment_start(self, segment + 1) < first + element_count ? segment_start(self, segment + 1) : first + element_count;
+        memcpy(vector_concurrent_slot(self, index), source, (end - index) * self->elements_size);
+        source += (end - index) * self->elements_size;
+        index = end;
+    }
+    vector_concurrent_publish(self, first, element_count);
+    return first;
+}
+/**
+ * @brief Push a element at concurrent vector end, from any thread.
+ *
+ * @param self          Concurrent vector that will hold the new element.
+ * @param element       Element to be added.
+ * @param element_size  Element size, must match the vector elements size.
+ *
+ * @return Return the index of the element, or SIZE_MAX on failure.
+ */
+size_t vector_concurrent_push_back(vector_concurrent_t* const self, const void* const element, const size_t element_size) {
+    return vector_concurrent_append_n(self, element, element_size, 1);
+}
@@ -0,0 +1,60 @@
+/*
+MIT License
+
+Copyright (c) 2018 Joseph Ojeda
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef VECTOR_CONCURRENT_H
+#define VECTOR_CONCURRENT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+ * Append-only vector safe for many concurrent producers and readers.
+ * Storage is a list of segments doubling in size that are never moved, so
+ * an element address stays valid until the vector is destroyed. Readers
+ * see elements up to vector_concurrent_size, which only covers fully
+ * written elements.
+ */
+typedef struct _internal_vector_concurrent vector_concurrent_t;
+///////////
+// Basic //
+///////////
+vector_concurrent_t*    vector_concurrent_init(const size_t elements_size, const size_t first_segment_count);
+void                    vector_concurrent_destroy(vector_concurrent_t* const self);
+////////////
+// Access //
+////////////
+void*                   vector_concurrent_at(vector_concurrent_t* const self, const size_t index);
+void                    vector_concurrent_for_each(vector_concurrent_t* const self, void (*function)(const void* const element, void* const context), void* const context);
+//////////////
+// Capacity //
+//////////////
+bool                    vector_concurrent_is_empty(vector_concurrent_t* const self);
+size_t                  vector_concurrent_size(vector_concurrent_t* const self);
+/////////////////
+// Operations //
+////////////////
+size_t                  vector_concurrent_append_n(vector_concurrent_t* const self, const void* const elements, const size_t element_size, const size_t element_count);
+size_t                  vector_concurrent_push_back(vector_concurrent_t* const self, const void* const element, const size_t element_size);
+
+#endif
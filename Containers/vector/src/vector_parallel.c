@@ -0,0 +1,581 @@
+/*
+MIT License
+
+Copyright (c) 2018 Joseph Ojeda
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <pthread.h>    // pthread_create, pthread_join, pthread_mutex_t, pthread_cond_t
+#include <stdlib.h>     // malloc, calloc, free, qsort
+#include <string.h>     // memcpy
+#include <unistd.h>     // sysconf
+
+#include "./vector_parallel.h"
+
+#define _CACHE_LINE_ 64
+#define _CHUNK_BYTES_ (64 * 1024)
+
+/*
+ * Range of chunk indices owned by one worker. The owner takes chunks from
+ * begin, idle workers steal them from end.
+ */
+typedef struct pool_queue {
+    _Alignas(_CACHE_LINE_) pthread_mutex_t lock;
+    size_t begin;
+    size_t end;
+} pool_queue;
+
+struct _internal_vector_pool {
+    pthread_t* threads;
+    pool_queue* queues;         // One per thread plus one for the submitting thread.
+    size_t threads_count;
+    pthread_mutex_t lock;
+    pthread_cond_t wake;
+    pthread_cond_t done;
+    size_t generation;
+    size_t active;
+    bool stop;
+    void (*task)(void* const job, const size_t chunk);
+    void* job;
+};
+
+typedef struct pool_worker {
+    vector_pool_t* pool;
+    size_t id;
+} pool_worker;
+
+static bool pool_take(pool_queue* const queue, size_t* const chunk, const bool steal) {
+    bool taken = false;
+    pthread_mutex_lock(&queue->lock);
+    if (queue->begin < queue->end) {
+        *chunk = steal ? --queue->end : queue->begin++;
+        taken = true;
+    }
+    pthread_mutex_unlock(&queue->lock);
+    return taken;
+}
+/*
+ * Drain the worker's own queue, then steal from the others until every
+ * queue is empty.
+ */
+static void pool_run(vector_pool_t* const pool, const size_t id) {
+    const size_t queues_count = pool->threads_count + 1;
+    size_t chunk = 0;
+    for (;;) {
+        if (pool_take(&pool->queues[id], &chunk, false)) {
+            pool->task(pool->job, chunk);
+            continue;
+        }
+        bool stolen = false;
+        for (size_t i = 1; i < queues_count && !stolen; ++i) {
+            stolen = pool_take(&pool->queues[(id + i) % queues_count], &chunk, true);
+        }
+        if (!stolen) {
+            return;
+        }
+        pool->task(pool->job, chunk);
+    }
+}
+
+static void* pool_thread(void* const argument) {
+    pool_worker* const worker = argument;
+    vector_pool_t* const pool = worker->pool;
+    size_t seen = 0;
+    for (;;) {
+        pthread_mutex_lock(&pool->lock);
+        while (!pool->stop && pool->generation == seen) {
+            pthread_cond_wait(&pool->wake, &pool->lock);
+        }
+        if (pool->stop) {
+            pthread_mutex_unlock(&pool->lock);
+            break;
+        }
+        seen = pool->generation;
+        pthread_mutex_unlock(&pool->lock);
+
+        pool_run(pool, worker->id);
+
+        pthread_mutex_lock(&pool->lock);
+        if (!--pool->active) {
+            pthread_cond_signal(&pool->done);
+        }
+        pthread_mutex_unlock(&pool->lock);
+    }
+    free(worker);
+    return NULL;
+}
+/*
+ * Split chunks_count chunks evenly over every queue, wake the workers and
+ * help out from the calling thread until the whole job is done.
+ */
+static void pool_execute(vector_pool_t* const pool, const size_t chunks_count, void (*task)(void* const job, const size_t chunk), void* const job) {
+    if (!chunks_count) {
+        return;
+    }
+    const size_t queues_count = pool->threads_count + 1;
+    if (chunks_count == 1 || !pool->threads_count) {
+        for (size_t i = 0; i < chunks_count; ++i) {
+            task(job, i);
+        }
+        return;
+    }
+    for (size_t i = 0; i < queues_count; ++i) {
+        pthread_mutex_lock(&pool->queues[i].lock);
+        pool->queues[i].begin = chunks_count * i / queues_count;
+        pool->queues[i].end = chunks_count * (i + 1) / queues_count;
+        pthread_mutex_unlock(&pool->queues[i].lock);
+    }
+    pthread_mutex_lock(&pool->lock);
+    pool->task = task;
+    pool->job = job;
+    pool->active = pool->threads_count;
+    pool->generation++;
+    pthread_cond_broadcast(&pool->wake);
+    pthread_mutex_unlock(&pool->lock);
+
+    pool_run(pool, pool->threads_count);
+
+    pthread_mutex_lock(&pool->lock);
+    while (pool->active) {
+        pthread_cond_wait(&pool->done, &pool->lock);
+    }
+    pthread_mutex_unlock(&pool->lock);
+}
+/*
+ * How a buffer is cut into chunks. The first chunk is longer so it ends on a
+ * cache line boundary of the buffer, every following chunk spans whole lines,
+ * so no two workers ever write the same line.
+ */
+typedef struct pool_chunks {
+    size_t first;       // Elements in chunk 0.
+    size_t elements;    // Elements in every later chunk.
+    size_t count;
+} pool_chunks;
+/*
+ * Split the size elements written at base: chunks of about _CHUNK_BYTES_
+ * counted with widest_size bytes per element, enough of them for every thread
+ * to steal from, aligned to cache lines when elements_size divides the gap
+ * up to the first line boundary.
+ */
+static pool_chunks pool_chunk_split(vector_pool_t* const pool, const void* const base, const size_t size, const size_t elements_size, const size_t widest_size) {
+    size_t elements = _CHUNK_BYTES_ / widest_size;
+    const size_t balanced = size / ((pool->threads_count + 1) * 4);
+    if (balanced < elements) {
+        elements = balanced;
+    }
+    size_t line = 1;
+    while ((line * elements_size) % _CACHE_LINE_ && line < _CACHE_LINE_) {
+        ++line;
+    }
+    elements = (elements + line - 1) / line * line;
+    if (!elements) {
+        elements = 1;
+    }
+    size_t lead = 0;
+    const size_t gap = (_CACHE_LINE_ - (uintptr_t)base % _CACHE_LINE_) % _CACHE_LINE_;
+    if (!(gap % elements_size)) {
+        lead = gap / elements_size;
+    }
+    pool_chunks chunks = { .first = lead + elements, .elements = elements, .count = 1 };
+    if (chunks.first < size) {
+        chunks.count += (size - chunks.first + elements - 1) / elements;
+    }
+    else {
+        chunks.first = size;
+    }
+    return chunks;
+}
+/*
+ * Element range [*begin, *end) of one chunk.
+ */
+static void pool_chunk_range(const pool_chunks* const chunks, const size_t size, const size_t chunk, size_t* const begin, size_t* const end) {
+    *begin = chunk ? chunks->first + (chunk - 1) * chunks->elements : 0;
+    *end = chunk ? *begin + chunks->elements : chunks->first;
+    if (*end > size) {
+        *end = size;
+    }
+}
+///////////
+// Basic //
+///////////
+/**
+ * @brief Initialize a new thread pool for parallel vector algorithms.
+ *
+ * @param threads_count Worker threads to start, the calling thread also works. 0 uses one per online CPU.
+ *
+ * @return A new thread pool.
+ */
+vector_pool_t* vector_pool_init(const size_t threads_count) {
+    size_t count = threads_count;
+    if (!count) {
+        const long online = sysconf(_SC_NPROCESSORS_ONLN);
+        count = online > 1 ? (size_t)online - 1 : 0;
+    }
+    vector_pool_t* init = malloc(sizeof(vector_pool_t));
+    if (!init) {
+        return NULL;
+    }
+    init->threads = calloc(count ? count : 1, sizeof(pthread_t));
+    init->queues = aligned_alloc(_CACHE_LINE_, (count + 1) * sizeof(pool_queue));
+    if (!init->threads || !init->queues) {
+        free(init->threads);
+        free(init->queues);
+        free(init);
+        return NULL;
+    }
+    for (size_t i = 0; i <= count; ++i) {
+        pthread_mutex_init(&init->queues[i].lock, NULL);
+        init->queues[i].begin = 0;
+        init->queues[i].end = 0;
+    }
+    pthread_mutex_init(&init->lock, NULL);
+    pthread_cond_init(&init->wake, NULL);
+    pthread_cond_init(&init->done, NULL);
+    init->generation = 0;
+    init->active = 0;
+    init->stop = false;
+    init->task = NULL;
+    init->job = NULL;
+    init->threads_count = 0;
+    for (size_t i = 0; i < count; ++i) {
+        pool_worker* worker = malloc(sizeof(pool_worker));
+        if (!worker) {
+            break;
+        }
+        worker->pool = init;
+        worker->id = i;
+        if (pthread_create(&init->threads[i], NULL, pool_thread, worker)) {
+            free(worker);
+            break;
+        }
+        init->threads_count++;
+    }
+    return init;
+}
+/**
+ * @brief Stop the worker threads and free a thread pool.
+ *
+ * @param self The thread pool to be freed.
+ */
+void vector_pool_destroy(vector_pool_t* const self) {
+    if (!self) {
+        return;
+    }
+    pthread_mutex_lock(&self->lock);
+    self->stop = true;
+    pthread_cond_broadcast(&self->wake);
+    pthread_mutex_unlock(&self->lock);
+    for (size_t i = 0; i < self->threads_count; ++i) {
+        pthread_join(self->threads[i], NULL);
+    }
+    for (size_t i = 0; i <= self->threads_count; ++i) {
+        pthread_mutex_destroy(&self->queues[i].lock);
+    }
+    pthread_mutex_destroy(&self->lock);
+    pthread_cond_destroy(&self->wake);
+    pthread_cond_destroy(&self->done);
+    free(self->threads);
+    free(self->queues);
+    free(self);
+}
+/**
+ * @brief Returns how many threads run jobs in a thread pool, the caller included.
+ *
+ * @param self Thread pool to retrieve size from.
+ *
+ * @return Return worker threads in self plus one.
+ */
+size_t vector_pool_size(vector_pool_t* const self) {
+    if (!self) {
+        return 0;
+    }
+    return self->threads_count + 1;
+}
+////////////////
+// Algorithms //
+////////////////
+typedef struct for_each_job {
+    uint8_t* elements;
+    size_t size;
+    size_t elements_size;
+    pool_chunks chunks;
+    void (*function)(void* const element, void* const context);
+    void* context;
+} for_each_job;
+
+static void for_each_task(void* const job, const size_t chunk) {
+    const for_each_job* const self = job;
+    size_t begin, end;
+    pool_chunk_range(&self->chunks, self->size, chunk, &begin, &end);
+    for (size_t i = begin; i < end; ++i) {
+        self->function(self->elements + i * self->elements_size, self->context);
+    }
+}
+/**
+ * @brief Call a function on every element of a vector container using a thread pool.
+ *
+ * @param pool      Thread pool that will run the calls.
+ * @param self      Vector container whose elements will be visited.
+ * @param function  Function called once per element, from any thread and in no particular order.
+ * @param context   Pointer handed unchanged to every function call.
+ */
+void vector_parallel_for_each(vector_pool_t* const pool, vector_t* const self, void (*function)(void* const element, void* const context), void* const context) {
+    if (!pool || !function || vector_is_empty(self)) {
+        return;
+    }
+    for_each_job job = {
+        .elements = vector_data(self),
+        .size = vector_size(self),
+        .elements_size = vector_elements_size(self),
+        .function = function,
+        .context = context
+    };
+    if (!job.elements) {
+        return;
+    }
+    job.chunks = pool_chunk_split(pool, job.elements, job.size, job.elements_size, job.elements_size);
+    pool_execute(pool, job.chunks.count, for_each_task, &job);
+}
+
+typedef struct transform_job {
+    uint8_t* dst;
+    const uint8_t* src;
+    size_t size;
+    size_t dst_elements_size;
+    size_t src_elements_size;
+    pool_chunks chunks;
+    void (*function)(void* const dst_element, const void* const src_element, void* const context);
+    void* context;
+} transform_job;
+
+static void transform_task(void* const job, const size_t chunk) {
+    const transform_job* const self = job;
+    size_t begin, end;
+    pool_chunk_range(&self->chunks, self->size, chunk, &begin, &end);
+    for (size_t i = begin; i < end; ++i) {
+        self->function(self->dst + i * self->dst_elements_size, self->src + i * self->src_elements_size, self->context);
+    }
+}
+/**
+ * @brief Write a function of every element of a vector container into another one using a thread pool.
+ *
+ * @param pool      Thread pool that will run the calls.
+ * @param dst       Vector container resized to src size that will hold the results. May be src.
+ * @param src       Vector container whose elements will be transformed.
+ * @param function  Function writing dst_element from src_element.
+ * @param context   Pointer handed unchanged to every function call.
+ */
+void vector_parallel_transform(vector_pool_t* const pool, vector_t* const dst, vector_t* const src, void (*function)(void* const dst_element, const void* const src_element, void* const context), void* const context) {
+    if (!pool || !dst || !function || vector_is_empty(src)) {
+        return;
+    }
+    const size_t size = vector_size(src);
+    if (dst != src) {
+        vector_reserve(dst, size);
+        vector_resize(dst, size, NULL);
+        if (vector_size(dst) != size) {
+            return;
+        }
+    }
+    // Resolve dst first, so an in-place transform reads the buffer it writes.
+    void* const output = vector_data(dst);
+    if (!output) {
+        return;
+    }
+    transform_job job = {
+        .dst = output,
+        .src = vector_cdata(src),
+        .size = size,
+        .dst_elements_size = vector_elements_size(dst),
+        .src_elements_size = vector_elements_size(src),
+        .function = function,
+        .context = context
+    };
+    const size_t widest = job.dst_elements_size > job.src_elements_size ? job.dst_elements_size : job.src_elements_size;
+    job.chunks = pool_chunk_split(pool, job.dst, size, job.dst_elements_size, widest);
+    pool_execute(pool, job.chunks.count, transform_task, &job);
+}
+
+typedef struct reduce_job {
+    const uint8_t* elements;
+    uint8_t* partials;
+    size_t size;
+    size_t elements_size;
+    size_t result_size;
+    pool_chunks chunks;
+    void (*reduce)(void* const accumulator, const void* const element, void* const context);
+    void* context;
+} reduce_job;
+
+static void reduce_task(void* const job, const size_t chunk) {
+    const reduce_job* const self = job;
+    size_t begin, end;
+    pool_chunk_range(&self->chunks, self->size, chunk, &begin, &end);
+    void* const accumulator = self->partials + chunk * self->result_size;
+    for (size_t i = begin; i < end; ++i) {
+        self->reduce(accumulator, self->elements + i * self->elements_size, self->context);
+    }
+}
+/**
+ * @brief Fold every element of a vector container into a single result using a thread pool.
+ *
+ * Each chunk folds into its own copy of the initial result, then the partial
+ * results are combined in element order, so combine only needs to be associative.
+ *
+ * @param pool          Thread pool that will run the calls.
+ * @param self          Vector container whose elements will be reduced.
+ * @param result        Holds the identity value on entry and the reduction on return.
+ * @param result_size   Size in bytes of result.
+ * @param reduce        Function folding one element into an accumulator.
+ * @param combine       Function folding the other accumulator into the first one.
+ * @param context       Pointer handed unchanged to every reduce and combine call.
+ */
+void vector_parallel_reduce(vector_pool_t* const pool, vector_t* const self, void* const result, const size_t result_size, void (*reduce)(void* const accumulator, const void* const element, void* const context), void (*combine)(void* const accumulator, const void* const other, void* const context), void* const context) {
+    if (!pool || !result || !result_size || !reduce || !combine || vector_is_empty(self)) {
+        return;
+    }
+    reduce_job job = {
+        .elements = vector_cdata(self),
+        .size = vector_size(self),
+        .elements_size = vector_elements_size(self),
+        .result_size = result_size,
+        .reduce = reduce,
+        .context = context
+    };
+    job.chunks = pool_chunk_split(pool, job.elements, job.size, job.elements_size, job.elements_size);
+    const size_t chunks_count = job.chunks.count;
+    job.partials = malloc(chunks_count * result_size);
+    if (!job.partials) {
+        return;
+    }
+    for (size_t i = 0; i < chunks_count; ++i) {
+        memcpy(job.partials + i * result_size, result, result_size);
+    }
+    pool_execute(pool, chunks_count, reduce_task, &job);
+    for (size_t i = 0; i < chunks_count; ++i) {
+        combine(result, job.partials + i * result_size, context);
+    }
+    free(job.partials);
+}
+
+typedef struct sort_job {
+    uint8_t* from;
+    uint8_t* to;
+    size_t size;
+    size_t elements_size;
+    size_t run_elements;
+    int (*compare)(const void* const a, const void* const b);
+} sort_job;
+
+static void sort_task(void* const job, const size_t chunk) {
+    const sort_job* const self = job;
+    const size_t begin = chunk * self->run_elements;
+    const size_t end = begin + self->run_elements < self->size ? begin + self->run_elements : self->size;
+    qsort(self->from + begin * self->elements_size, end - begin, self->elements_size, (int (*)(const void*, const void*))self->compare);
+}
+/*
+ * Merge the sorted runs [begin, middle) and [middle, end) of from into to,
+ * copying stretches of one run at a time.
+ */
+static void merge_task(void* const job, const size_t chunk) {
+    const sort_job* const self = job;
+    const size_t es = self->elements_size;
+    const size_t begin = chunk * self->run_elements * 2;
+    const size_t middle = begin + self->run_elements < self->size ? begin + self->run_elements : self->size;
+    const size_t end = middle + self->run_elements < self->size ? middle + self->run_elements : self->size;
+    size_t left = begin;
+    size_t right = middle;
+    size_t out = begin;
+    while (left < middle && right < end) {
+        size_t run = left;
+        while (run < middle && self->compare(self->from + run * es, self->from + right * es) <= 0) {
+            ++run;
+        }
+        memcpy(self->to + out * es, self->from + left * es, (run - left) * es);
+        out += run - left;
+        left = run;
+        if (left == middle) {
+            break;
+        }
+        run = right;
+        while (run < end && self->compare(self->from + run * es, self->from + left * es) < 0) {
+            ++run;
+        }
+        memcpy(self->to + out * es, self->from + right * es, (run - right) * es);
+        out += run - right;
+        right = run;
+    }
+    memcpy(self->to + out * es, self->from + left * es, (middle - left) * es);
+    out += middle - left;
+    memcpy(self->to + out * es, self->from + right * es, (end - right) * es);
+}
+/**
+ * @brief Sort a vector container using a thread pool.
+ *
+ * Chunks are sorted in parallel, then merged pairwise in parallel rounds
+ * through a scratch buffer of the same size. Without memory for that buffer
+ * the whole vector is sorted by the calling thread. The sort is not stable.
+ *
+ * @param pool      Thread pool that will run the sort.
+ * @param self      Vector container to be sorted.
+ * @param compare   qsort style comparison function.
+ */
+void vector_parallel_sort(vector_pool_t* const pool, vector_t* const self, int (*compare)(const void* const a, const void* const b)) {
+    if (!pool || !compare || vector_size(self) < 2) {
+        return;
+    }
+    sort_job job = {
+        .from = vector_data(self),
+        .size = vector_size(self),
+        .elements_size = vector_elements_size(self),
+        .compare = compare
+    };
+    if (!job.from) {
+        return;
+    }
+    job.run_elements = (job.size + vector_pool_size(pool) - 1) / vector_pool_size(pool);
+    uint8_t* const elements = job.from;
+    uint8_t* scratch = NULL;
+    if (job.run_elements < job.size) {
+        scratch = malloc(job.size * job.elements_size);
+        if (!scratch) {
+            // No room to merge runs, sort the whole vector on this thread instead.
+            qsort(elements, job.size, job.elements_size, (int (*)(const void*, const void*))compare);
+            return;
+        }
+    }
+    pool_execute(pool, (job.size + job.run_elements - 1) / job.run_elements, sort_task, &job);
+    if (!scratch) {
+        return;
+    }
+    job.to = scratch;
+    while (job.run_elements < job.size) {
+        const size_t pairs = (job.size + job.run_elements * 2 - 1) / (job.run_elements * 2);
+        pool_execute(pool, pairs, merge_task, &job);
+        uint8_t* const temp = job.from;
+        job.from = job.to;
+        job.to = temp;
+        job.run_elements *= 2;
+    }
+    if (job.from != elements) {
+        memcpy(elements, job.from, job.size * job.elements_size);
+    }
+    free(scratch);
+}
@@ -0,0 +1,54 @@
+/*
+MIT License
+
+Copyright (c) 2018 Joseph Ojeda
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef VECTOR_PARALLEL_H
+#define VECTOR_PARALLEL_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "./vector.h"
+
+/*
+ * Thread pool running one parallel algorithm at a time. It is not
+ * reentrant: calling a vector_parallel_* function with the same pool from
+ * inside an element function deadlocks, and two threads must not run
+ * algorithms on the same pool at once.
+ */
+typedef struct _internal_vector_pool vector_pool_t;
+///////////
+// Basic //
+///////////
+vector_pool_t*  vector_pool_init(const size_t threads_count);
+void            vector_pool_destroy(vector_pool_t* const self);
+size_t          vector_pool_size(vector_pool_t* const self);
+////////////////
+// Algorithms //
+////////////////
+void            vector_parallel_for_each(vector_pool_t* const pool, vector_t* const self, void (*function)(void* const element, void* const context), void* const context);
+void            vector_parallel_transform(vector_pool_t* const pool, vector_t* const dst, vector_t* const src, void (*function)(void* const dst_element, const void* const src_element, void* const context), void* const context);
+void            vector_parallel_reduce(vector_pool_t* const pool, vector_t* const self, void* const result, const size_t result_size, void (*reduce)(void* const accumulator, const void* const element, void* const context), void (*combine)(void* const accumulator, const void* const other, void* const context), void* const context);
+void            vector_parallel_sort(vector_pool_t* const pool, vector_t* const self, int (*compare)(const void* const a, const void* const b));
+
+#endif
@@ -0,0 +1,581 @@
+/*
+MIT License
+
+Copyright (c) 2018 Joseph Ojeda
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <stdlib.h> // malloc, free
+#include <string.h> // memcpy, memmove
+
+#include "./vector_sort.h"
+#include "./vector_view.h"
+
+#define _INSERTION_THRESHOLD_ 16
+#define _SWAP_BUFFER_ 256
+
+static size_t depth_limit(size_t size) {
+    size_t depth = 0;
+    while (size >>= 1) {
+        ++depth;
+    }
+    return depth * 2;
+}
+/////////////////////////
+// Generic introsort   //
+/////////////////////////
+static void generic_swap(uint8_t* const a, uint8_t* const b, size_t elements_size) {
+    uint8_t* left = a;
+    uint8_t* right = b;
+    uint64_t word = 0;
+    for (; elements_size >= sizeof(word); elements_size -= sizeof(word), left += sizeof(word), right += sizeof(word)) {
+        memcpy(&word, left, sizeof(word));
+        memcpy(left, right, sizeof(word));
+        memcpy(right, &word, sizeof(word));
+    }
+    while (elements_size--) {
+        const uint8_t byte = *left;
+        *left++ = *right;
+        *right++ = byte;
+    }
+}
+
+static void generic_insertion(uint8_t* const base, const size_t size, const size_t es, vector_compare compare, uint8_t* const temp) {
+    for (size_t i = 1; i < size; ++i) {
+        if (compare(base + i * es, base + (i - 1) * es) >= 0) {
+            continue;
+        }
+        memcpy(temp, base + i * es, es);
+        size_t j = i;
+        while (j && compare(temp, base + (j - 1) * es) < 0) {
+            --j;
+        }
+        memmove(base + (j + 1) * es, base + j * es, (i - j) * es);
+        memcpy(base + j * es, temp, es);
+    }
+}
+
+static void generic_sift(uint8_t* const base, size_t root, const size_t size, const size_t es, vector_compare compare) {
+    for (size_t child = root * 2 + 1; child < size; child = root * 2 + 1) {
+        if (child + 1 < size && compare(base + child * es, base + (child + 1) * es) < 0) {
+            ++child;
+        }
+        if (compare(base + root * es, base + child * es) >= 0) {
+            return;
+        }
+        generic_swap(base + root * es, base + child * es, es);
+        root = child;
+    }
+}
+
+static void generic_heapsort(uint8_t* const base, const size_t size, const size_t es, vector_compare compare) {
+    for (size_t i = size / 2; i-- > 0;) {
+        generic_sift(base, i, size, es, compare);
+    }
+    for (size_t i = size - 1; i > 0; --i) {
+        generic_swap(base, base + i * es, es);
+        generic_sift(base, 0, i, es, compare);
+    }
+}
+/*
+ * Median of three moved to base[0] as the pivot, with the smaller sample
+ * left in the middle and the larger one at the end as scan sentinels.
+ */
+static size_t generic_partition(uint8_t* const base, const size_t size, const size_t es, vector_compare compare) {
+    uint8_t* const low = base;
+    uint8_t* const middle = base + (size / 2) * es;
+    uint8_t* const high = base + (size - 1) * es;
+    if (compare(middle, low) < 0) {
+        generic_swap(middle, low, es);
+    }
+    if (compare(high, middle) < 0) {
+        generic_swap(high, middle, es);
+        if (compare(middle, low) < 0) {
+            generic_swap(middle, low, es);
+        }
+    }
+    generic_swap(low, middle, es);
+    size_t i = 1;
+    size_t j = size - 1;
+    for (;;) {
+        while (compare(base + i * es, base) < 0) {
+            ++i;
+        }
+        while (compare(base, base + j * es) < 0) {
+            --j;
+        }
+        if (i >= j) {
+            break;
+        }
+        generic_swap(base + i * es, base + j * es, es);
+        ++i;
+        --j;
+    }
+    generic_swap(base, base + j * es, es);
+    return j;
+}
+
+static void generic_introsort(uint8_t* base, size_t size, const size_t es, vector_compare compare, size_t depth, uint8_t* const temp) {
+    while (size > _INSERTION_THRESHOLD_) {
+        if (!depth--) {
+            generic_heapsort(base, size, es, compare);
+            return;
+        }
+        const size_t pivot = generic_partition(base, size, es, compare);
+        const size_t right = size - pivot - 1;
+        if (pivot < right) {
+            generic_introsort(base, pivot, es, compare, depth, temp);
+            base += (pivot + 1) * es;
+            size = right;
+        }
+        else {
+            generic_introsort(base + (pivot + 1) * es, right, es, compare, depth, temp);
+            size = pivot;
+        }
+    }
+    generic_insertion(base, size, es, compare, temp);
+}
+/////////////////////////
+// Typed introsort     //
+/////////////////////////
+/*
+ * Same algorithm as above with the comparison and swap inlined for one key
+ * type, so the compiler sees plain loads and compares.
+ */
+#define _VECTOR_TYPED_SORT_(name, type)                                                     \
+    static void name##_insertion(type* const base, const size_t size) {                     \
+        for (size_t i = 1; i < size; ++i) {                                                 \
+            const type value = base[i];                                                     \
+            size_t j = i;                                                                   \
+            for (; j && value < base[j - 1]; --j) {                                         \
+                base[j] = base[j - 1];                                                      \
+            }                                                                               \
+            base[j] = value;                                                                \
+        }                                                                                   \
+    }                                                                                       \
+    static void name##_sift(type* const base, size_t root, const size_t size) {             \
+        const type value = base[root];                                                      \
+        for (size_t child = root * 2 + 1; child < size; child = root * 2 + 1) {             \
+            if (child + 1 < size && base[child] < base[child + 1]) {                        \
+                ++child;                                                                    \
+            }                                                                               \
+            if (!(value < base[child])) {                                                   \
+                break;                                                                      \
+            }                                                                               \
+            base[root] = base[child];                                                       \
+            root = child;                                                                   \
+        }                                                                                   \
+        base[root] = value;                                                                 \
+    }                                                                                       \
+    static void name##_heapsort(type* const base, const size_t size) {                      \
+        for (size_t i = size / 2; i-- > 0;) {                                               \
+            name##_sift(base, i, size);                                                     \
+        }                                                                                   \
+        for (size_t i = size - 1; i > 0; --i) {                                             \
+            const type temp = base[0];                                                      \
+            base[0] = base[i];                                                              \
+            base[i] = temp;                                                                 \
+            name##_sift(base, 0, i);                                                        \
+        }                                                                                   \
+    }                                                                                       \
+    static void name##_introsort(type* base, size_t size, size_t depth) {                   \
+        while (size > _INSERTION_THRESHOLD_) {                                              \
+            if (!depth--) {                                                                 \
+                name##_heapsort(base, size);                                                \
+                return;                                                                     \
+            }                                                                               \
+            type* const middle = base + size / 2;                                           \
+            type* const high = base + size - 1;                                             \
+            type temp;                                                                      \
+            if (*middle < *base) { temp = *middle; *middle = *base; *base = temp; }         \
+            if (*high < *middle) {                                                          \
+                temp = *high; *high = *middle; *middle = temp;                              \
+                if (*middle < *base) { temp = *middle; *middle = *base; *base = temp; }     \
+            }                                                                               \
+            temp = *base; *base = *middle; *middle = temp;                                  \
+            const type pivot = *base;                                                       \
+            size_t i = 1;                                                                   \
+            size_t j = size - 1;                                                            \
+            for (;;) {                                                                      \
+                while (base[i] < pivot) {                                                   \
+                    ++i;                                                                    \
+                }                                                                           \
+                while (pivot < base[j]) {                                                   \
+                    --j;                                                                    \
+                }                                                                           \
+                if (i >= j) {                                                               \
+                    break;                                                                  \
+                }                                                                           \
+                temp = base[i]; base[i] = base[j]; base[j] = temp;                          \
+                ++i;                                                                        \
+                --j;                                                                        \
+            }                                                                               \
+            base[0] = base[j];                                                              \
+            base[j] = pivot;                                                                \
+            const size_t right = size - j - 1;                                              \
+            if (j < right) {                                                                \
+                name##_introsort(base, j, depth);                                           \
+                base += j + 1;                                                              \
+                size = right;                                                               \
+            }                                                                               \
+            else {                                                                          \
+                name##_introsort(base + j + 1, right, depth);                               \
+                size = j;                                                                   \
+            }                                                                               \
+        }                                                                                   \
+        name##_insertion(base, size);                                                       \
+    }
+
+_VECTOR_TYPED_SORT_(int32, int32_t)
+_VECTOR_TYPED_SORT_(uint32, uint32_t)
+_VECTOR_TYPED_SORT_(int64, int64_t)
+_VECTOR_TYPED_SORT_(uint64, uint64_t)
+_VECTOR_TYPED_SORT_(float, float)
+_VECTOR_TYPED_SORT_(double, double)
+
+static size_t key_width(const vector_key key) {
+    switch (key) {
+        case VECTOR_KEY_INT32:
+        case VECTOR_KEY_UINT32:
+        case VECTOR_KEY_FLOAT:
+            return 4;
+        case VECTOR_KEY_INT64:
+        case VECTOR_KEY_UINT64:
+        case VECTOR_KEY_DOUBLE:
+            return 8;
+    }
+    return 0;
+}
+/*
+ * Map a key to an unsigned integer with the same ordering, so radix passes
+ * only ever see unsigned digits.
+ */
+static uint64_t radix_value(const uint8_t* const element, const vector_key key) {
+    uint32_t word = 0;
+    uint64_t dword = 0;
+    switch (key) {
+        case VECTOR_KEY_INT32:
+            memcpy(&word, element, sizeof(word));
+            return word ^ UINT32_C(0x80000000);
+        case VECTOR_KEY_UINT32:
+            memcpy(&word, element, sizeof(word));
+            return word;
+        case VECTOR_KEY_FLOAT:
+            memcpy(&word, element, sizeof(word));
+            return word & UINT32_C(0x80000000) ? ~word & UINT32_C(0xFFFFFFFF) : word | UINT32_C(0x80000000);
+        case VECTOR_KEY_INT64:
+            memcpy(&dword, element, sizeof(dword));
+            return dword ^ UINT64_C(0x8000000000000000);
+        case VECTOR_KEY_UINT64:
+            memcpy(&dword, element, sizeof(dword));
+            return dword;
+        case VECTOR_KEY_DOUBLE:
+            memcpy(&dword, element, sizeof(dword));
+            return dword & UINT64_C(0x8000000000000000) ? ~dword : dword | UINT64_C(0x8000000000000000);
+    }
+    return 0;
+}
+/////////////
+// Sorting //
+/////////////
+/**
+ * @brief Sort a vector container with introsort.
+ *
+ * Quicksort with median of three pivots, insertion sort for short ranges and
+ * a heapsort fallback bounding the worst case to O(n log n). Not stable.
+ *
+ * @param self      Vector container to be sorted.
+ * @param compare   qsort style comparison function.
+ */
+void vector_sort(vector_t* const self, vector_compare compare) {
+    if (!compare || vector_size(self) < 2) {
+        return;
+    }
+    // A shared buffer that fails to detach leaves no writable data.
+    void* const data = vector_data(self);
+    if (!data) {
+        return;
+    }
+    const size_t es = vector_elements_size(self);
+    uint8_t buffer[_SWAP_BUFFER_];
+    uint8_t* const temp = es <= _SWAP_BUFFER_ ? buffer : malloc(es);
+    if (!temp) {
+        return;
+    }
+    generic_introsort(data, vector_size(self), es, compare, depth_limit(vector_size(self)), temp);
+    if (temp != buffer) {
+        free(temp);
+    }
+}
+/**
+ * @brief Sort a vector container whose elements are plain numeric keys.
+ *
+ * Uses an introsort specialized for the key type, with no comparator calls.
+ * NaN floating point keys end up in unspecified positions.
+ *
+ * @param self  Vector container to be sorted. Its elements size must match the key width.
+ * @param key   Type of every element.
+ */
+void vector_sort_key(vector_t* const self, const vector_key key) {
+    if (vector_size(self) < 2 || vector_elements_size(self) != key_width(key)) {
+        return;
+    }
+    void* const data = vector_data(self);
+    if (!data) {
+        return;
+    }
+    const size_t size = vector_size(self);
+    const size_t depth = depth_limit(size);
+    switch (key) {
+        case VECTOR_KEY_INT32:  int32_introsort(data, size, depth);  break;
+        case VECTOR_KEY_UINT32: uint32_introsort(data, size, depth); break;
+        case VECTOR_KEY_INT64:  int64_introsort(data, size, depth);  break;
+        case VECTOR_KEY_UINT64: uint64_introsort(data, size, depth); break;
+        case VECTOR_KEY_FLOAT:  float_introsort(data, size, depth);  break;
+        case VECTOR_KEY_DOUBLE: double_introsort(data, size, depth); break;
+    }
+}
+/**
+ * @brief Stable LSD radix sort of a vector container by a fixed-width numeric key.
+ *
+ * One byte per pass, all histograms built in a single read, and passes where
+ * every element shares the same byte skipped. Needs a scratch buffer as large
+ * as the vector.
+ *
+ * @param self          Vector container to be sorted.
+ * @param key           Type of the key field.
+ * @param key_offset    Byte offset of the key inside each element.
+ */
+void vector_radix_sort(vector_t* const self, const vector_key key, const size_t key_offset) {
+    const size_t es = vector_elements_size(self);
+    const size_t width = key_width(key);
+    const size_t size = vector_size(self);
+    if (size < 2 || key_offset + width > es) {
+        return;
+    }
+    uint8_t* from = vector_data(self);
+    if (!from) {
+        return;
+    }
+    size_t (*counts)[256] = calloc(width, sizeof(*counts));
+    uint8_t* const scratch = malloc(size * es);
+    if (!counts || !scratch) {
+        free(counts);
+        free(scratch);
+        return;
+    }
+    uint8_t* to = scratch;
+    for (size_t i = 0; i < size; ++i) {
+        const uint64_t value = radix_value(from + i * es + key_offset, key);
+        for (size_t pass = 0; pass < width; ++pass) {
+            counts[pass][(value >> (pass * 8)) & 0xFF]++;
+        }
+    }
+    for (size_t pass = 0; pass < width; ++pass) {
+        size_t* const count = counts[pass];
+        if (count[(radix_value(from + key_offset, key) >> (pass * 8)) & 0xFF] == size) {
+            continue;
+        }
+        size_t offset = 0;
+        for (size_t digit = 0; digit < 256; ++digit) {
+            const size_t digit_count = count[digit];
+            count[digit] = offset;
+            offset += digit_count;
+        }
+        for (size_t i = 0; i < size; ++i) {
+            const uint8_t digit = (radix_value(from + i * es + key_offset, key) >> (pass * 8)) & 0xFF;
+            memcpy(to + count[digit]++ * es, from + i * es, es);
+        }
+        uint8_t* const temp = from;
+        from = to;
+        to = temp;
+    }
+    if (from == scratch) {
+        memcpy(vector_data(self), scratch, size * es);
+    }
+    free(scratch);
+    free(counts);
+}
+/**
+ * @brief Returns if a vector container is sorted.
+ *
+ * @param self      Vector container to check.
+ * @param compare   qsort style comparison function.
+ *
+ * @return Return true if no element compares lower than the one before it.
+ */
+bool vector_is_sorted(vector_t* const self, vector_compare compare) {
+    const vector_view_t view = vector_view(self);
+    return vector_view_is_sorted(&view, compare);
+}
+///////////////
+// Searching //
+///////////////
+/**
+ * @brief Find an element equal to key in a sorted vector container.
+ *
+ * @param self      Sorted vector container to search.
+ * @param key       Element to look for.
+ * @param compare   qsort style comparison function.
+ *
+ * @return Return a pointer to a matching element, or NULL if there is none.
+ */
+void* vector_binary_search(vector_t* const self, const void* const key, vector_compare compare) {
+    const vector_view_t view = vector_view(self);
+    return (void*)vector_view_binary_search(&view, key, compare);
+}
+/**
+ * @brief Find the first position in a sorted vector container not lower than key.
+ *
+ * @param self      Sorted vector container to search.
+ * @param key       Element to look for.
+ * @param compare   qsort style comparison function.
+ *
+ * @return Return the index of the first element not lower than key, or the vector size.
+ */
+size_t vector_lower_bound(vector_t* const self, const void* const key, vector_compare compare) {
+    const vector_view_t view = vector_view(self);
+    return vector_view_lower_bound(&view, key, compare);
+}
+/**
+ * @brief Find the first position in a sorted vector container greater than key.
+ *
+ * @param self      Sorted vector container to search.
+ * @param key       Element to look for.
+ * @param compare   qsort style comparison function.
+ *
+ * @return Return the index of the first element greater than key, or the vector size.
+ */
+size_t vector_upper_bound(vector_t* const self, const void* const key, vector_compare compare) {
+    const vector_view_t view = vector_view(self);
+    return vector_view_upper_bound(&view, key, compare);
+}
+/**
+ * @brief Find the range of elements equal to key in a sorted vector container.
+ *
+ * @param self      Sorted vector container to search.
+ * @param key       Element to look for.
+ * @param compare   qsort style comparison function.
+ * @param first     Receives the index of the first equal element.
+ * @param last      Receives the index one past the last equal element.
+ */
+void vector_equal_range(vector_t* const self, const void* const key, vector_compare compare, size_t* const first, size_t* const last) {
+    if (!first || !last) {
+        return;
+    }
+    *first = vector_lower_bound(self, key, compare);
+    *last = vector_upper_bound(self, key, compare);
+}
+////////////////
+// Operations //
+////////////////
+/**
+ * @brief Remove consecutive equal elements from a vector container, keeping the first of each run.
+ *
+ * @param self      Vector container to deduplicate, usually sorted.
+ * @param compare   qsort style comparison function.
+ *
+ * @return Return how many elements were removed from self.
+ */
+size_t vector_unique(vector_t* const self, vector_compare compare) {
+    const size_t size = vector_size(self);
+    if (!compare || size < 2) {
+        return 0;
+    }
+    uint8_t* const data = vector_data(self);
+    if (!data) {
+        return 0;
+    }
+    const size_t es = vector_elements_size(self);
+    size_t write = 1;
+    for (size_t i = 1; i < size; ++i) {
+        if (compare(data + (write - 1) * es, data + i * es)) {
+            if (write != i) {
+                memcpy(data + write * es, data + i * es, es);
+            }
+            ++write;
+        }
+    }
+    vector_erase(self, write, size - 1);
+    return size - write;
+}
+/**
+ * @brief Merge two sorted vector containers into another one.
+ *
+ * Runs taken from the same input are appended as one block. Equal elements
+ * from a come before those from b.
+ *
+ * @param dst       Vector container that will hold the merge, NULL creates one. Must not be a or b.
+ * @param a         First sorted vector container.
+ * @param b         Second sorted vector container.
+ * @param compare   qsort style comparison function.
+ *
+ * @return Return dst containing every element of a and b in order, or NULL if the elements
+ *         sizes of dst, a and b differ or dst could not hold the result. dst is left
+ *         untouched on a size mismatch.
+ */
+vector_t* vector_merge(vector_t* dst, vector_t* const a, vector_t* const b, vector_compare compare) {
+    const size_t es = vector_elements_size(a);
+    if (!a || !b || !compare || es != vector_elements_size(b) || dst == a || dst == b ||
+        (dst && vector_elements_size(dst) != es)) {
+        return NULL;
+    }
+    vector_t* const created = dst ? NULL : vector_init(es, vector_size(a) + vector_size(b));
+    if (!dst) {
+        if (!created) {
+            return NULL;
+        }
+        dst = created;
+    }
+    else {
+        vector_clear(dst);
+    }
+    vector_reserve(dst, vector_size(a) + vector_size(b));
+    if (vector_capacity(dst) < vector_size(a) + vector_size(b)) {
+        vector_destroy(created);
+        return NULL;
+    }
+    const uint8_t* const left = vector_cdata(a);
+    const uint8_t* const right = vector_cdata(b);
+    const size_t left_size = vector_size(a);
+    const size_t right_size = vector_size(b);
+    size_t i = 0;
+    size_t j = 0;
+    while (i < left_size && j < right_size) {
+        size_t run = i;
+        while (run < left_size && compare(left + run * es, right + j * es) <= 0) {
+            ++run;
+        }
+        vector_append_n(dst, left + i * es, es, run - i);
+        i = run;
+        if (i == left_size) {
+            break;
+        }
+        run = j;
+        while (run < right_size && compare(right + run * es, left + i * es) < 0) {
+            ++run;
+        }
+        vector_append_n(dst, right + j * es, es, run - j);
+        j = run;
+    }
+    vector_append_n(dst, left + i * es, es, left_size - i);
+    vector_append_n(dst, right + j * es, es, right_size - j);
+    return dst;
+}
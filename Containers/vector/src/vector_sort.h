@@ -0,0 +1,67 @@
+/*
+MIT License
+
+Copyright (c) 2018 Joseph Ojeda
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef VECTOR_SORT_H
+#define VECTOR_SORT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "./vector.h"
+
+/*
+ * Fixed-width key types for the typed sorts. The key is either the whole
+ * element or, for vector_radix_sort, a field at a given byte offset.
+ */
+typedef enum vector_key {
+    VECTOR_KEY_INT32,
+    VECTOR_KEY_UINT32,
+    VECTOR_KEY_INT64,
+    VECTOR_KEY_UINT64,
+    VECTOR_KEY_FLOAT,
+    VECTOR_KEY_DOUBLE
+} vector_key;
+
+typedef int (*vector_compare)(const void* const a, const void* const b);
+/////////////
+// Sorting //
+/////////////
+void        vector_sort(vector_t* const self, vector_compare compare);
+void        vector_sort_key(vector_t* const self, const vector_key key);
+void        vector_radix_sort(vector_t* const self, const vector_key key, const size_t key_offset);
+bool        vector_is_sorted(vector_t* const self, vector_compare compare);
+///////////////
+// Searching //
+///////////////
+void*       vector_binary_search(vector_t* const self, const void* const key, vector_compare compare);
+size_t      vector_lower_bound(vector_t* const self, const void* const key, vector_compare compare);
+size_t      vector_upper_bound(vector_t* const self, const void* const key, vector_compare compare);
+void        vector_equal_range(vector_t* const self, const void* const key, vector_compare compare, size_t* const first, size_t* const last);
+////////////////
+// Operations //
+////////////////
+size_t      vector_unique(vector_t* const self, vector_compare compare);
+vector_t*   vector_merge(vector_t* dst, vector_t* const a, vector_t* const b, vector_compare compare);
+
+#endif
@@ -0,0 +1,166 @@
+/*
+MIT License
+
+Copyright (c) 2018 Joseph Ojeda
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef VECTOR_TYPED_H
+#define VECTOR_TYPED_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h> // realloc, free
+#include <string.h> // memmove
+
+#include "./vector.h"
+
+/*
+ * VECTOR_DEFINE(name, type) generates vec_name_t, a vector of type whose
+ * functions are all static inline, so element size is a compile-time
+ * constant and loops over vec_name_data can be vectorized. Growth follows
+ * vector_grow_capacity, the same policy as vector_t.
+ *
+ *      VECTOR_DEFINE(int32, int32_t)
+ *
+ *      vec_int32_t numbers = VECTOR_EMPTY;
+ *      vec_int32_push(&numbers, 7);
+ *      vec_int32_destroy(&numbers);
+ */
+#define VECTOR_EMPTY { NULL, 0, 0 }
+
+#define VECTOR_DEFINE(name, type)                                                               \
+    typedef struct vec_##name {                                                                 \
+        type* data;                                                                             \
+        size_t size;                                                                            \
+        size_t capacity;                                                                        \
+    } vec_##name##_t;                                                                           \
+    /* Basic */                                                                                 \
+    static inline void vec_##name##_init(vec_##name##_t* const self) {                          \
+        self->data = NULL;                                                                      \
+        self->size = 0;                                                                         \
+        self->capacity = 0;                                                                     \
+    }                                                                                           \
+    static inline void vec_##name##_destroy(vec_##name##_t* const self) {                       \
+        free(self->data);                                                                       \
+        vec_##name##_init(self);                                                                \
+    }                                                                                           \
+    /* Access */                                                                                \
+    static inline type* vec_##name##_at(vec_##name##_t* const self, const size_t index) {       \
+        return self->data + index;                                                              \
+    }                                                                                           \
+    static inline type vec_##name##_get(const vec_##name##_t* const self, const size_t index) { \
+        return self->data[index];                                                               \
+    }                                                                                           \
+    static inline type* vec_##name##_back(vec_##name##_t* const self) {                         \
+        return self->size ? self->data + self->size - 1 : NULL;                                 \
+    }                                                                                           \
+    static inline type* vec_##name##_data(vec_##name##_t* const self) {                         \
+        return self->data;                                                                      \
+    }                                                                                           \
+    /* Capacity */                                                                              \
+    static inline size_t vec_##name##_size(const vec_##name##_t* const self) {                  \
+        return self->size;                                                                      \
+    }                                                                                           \
+    static inline size_t vec_##name##_capacity(const vec_##name##_t* const self) {              \
+        return self->capacity;                                                                  \
+    }                                                                                           \
+    static inline bool vec_##name##_is_empty(const vec_##name##_t* const self) {                \
+        return !self->size;                                                                     \
+    }                                                                                           \
+    static inline bool vec_##name##_reserve(vec_##name##_t* const self, const size_t size) {    \
+        if (size <= self->capacity) {                                                           \
+            return true;                                                                        \
+        }                                                                                       \
+        if (size > SIZE_MAX / sizeof(type)) {                                                   \
+            return false;                                                                       \
+        }                                                                                       \
+        size_t capacity = vector_grow_capacity(size);                                           \
+        if (capacity > SIZE_MAX / sizeof(type)) {                                               \
+            capacity = size; /* Growth slack would overflow the byte count. */                  \
+        }                                                                                       \
+        type* temp = realloc(self->data, capacity * sizeof(type));                              \
+        if (!temp) {                                                                            \
+            return false;                                                                       \
+        }                                                                                       \
+        self->data = temp;                                                                      \
+        self->capacity = capacity;                                                              \
+        return true;                                                                            \
+    }                                                                                           \
+    static inline bool vec_##name##_resize(vec_##name##_t* const self, const size_t size, const type value) { \
+        if (!vec_##name##_reserve(self, size)) {                                                \
+            return false;                                                                       \
+        }                                                                                       \
+        for (size_t i = self->size; i < size; ++i) {                                            \
+            self->data[i] = value;                                                              \
+        }                                                                                       \
+        self->size = size;                                                                      \
+        return true;                                                                            \
+    }                                                                                           \
+    /* Operations */                                                                            \
+    static inline void vec_##name##_clear(vec_##name##_t* const self) {                         \
+        self->size = 0;                                                                         \
+    }                                                                                           \
+    static inline bool vec_##name##_push(vec_##name##_t* const self, const type value) {        \
+        if (self->size == self->capacity && !vec_##name##_reserve(self, self->size + 1)) {      \
+            return false;                                                                       \
+        }                                                                                       \
+        self->data[self->size++] = value;                                                       \
+        return true;                                                                            \
+    }                                                                                           \
+    static inline bool vec_##name##_append_n(vec_##name##_t* const self, const type* const values, const size_t count) { \
+        /* values may point into data, find it again once the reserve moved data. */            \
+        const uintptr_t base = (uintptr_t)self->data;                                           \
+        const bool inside = (uintptr_t)values >= base && (uintptr_t)values < base + self->size * sizeof(type); \
+        const size_t offset = inside ? ((uintptr_t)values - base) / sizeof(type) : 0;           \
+        if (count > SIZE_MAX - self->size || !vec_##name##_reserve(self, self->size + count)) { \
+            return false;                                                                       \
+        }                                                                                       \
+        const type* const source = inside ? self->data + offset : values;                       \
+        for (size_t i = 0; i < count; ++i) {                                                    \
+            self->data[self->size + i] = source[i];                                             \
+        }                                                                                       \
+        self->size += count;                                                                    \
+        return true;                                                                            \
+    }                                                                                           \
+    static inline void vec_##name##_pop(vec_##name##_t* const self) {                           \
+        if (self->size) {                                                                       \
+            self->size--;                                                                       \
+        }                                                                                       \
+    }                                                                                           \
+    static inline bool vec_##name##_insert(vec_##name##_t* const self, const size_t index, const type value) { \
+        if (index > self->size || !vec_##name##_reserve(self, self->size + 1)) {                \
+            return false;                                                                       \
+        }                                                                                       \
+        memmove(self->data + index + 1, self->data + index, (self->size - index) * sizeof(type)); \
+        self->data[index] = value;                                                              \
+        self->size++;                                                                           \
+        return true;                                                                            \
+    }                                                                                           \
+    static inline void vec_##name##_erase(vec_##name##_t* const self, const size_t start, const size_t end) { \
+        if (start >= self->size || end < start) {                                               \
+            return;                                                                             \
+        }                                                                                       \
+        const size_t last = end < self->size ? end : self->size - 1;                            \
+        memmove(self->data + start, self->data + last + 1, (self->size - last - 1) * sizeof(type)); \
+        self->size -= last - start + 1;                                                         \
+    }
+
+#endif
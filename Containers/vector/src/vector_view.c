@@ -0,0 +1,374 @@
+/*
+MIT License
+
+Copyright (c) 2018 Joseph Ojeda
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <string.h> // memcpy
+
+#include "./vector_view.h"
+
+static const vector_view_t _EMPTY_VIEW_ = { NULL, 0, 0, 0 };
+
+static const uint8_t* view_element(const vector_view_t* const self, const size_t index) {
+    return (const uint8_t*)self->data + index * self->stride;
+}
+/*
+ * Check if a view looks into the buffer of a vector container.
+ */
+static bool view_overlaps(const vector_view_t* const self, vector_t* const vector) {
+    const uint8_t* const begin = vector_cdata(vector);
+    if (!self->size || !begin) {
+        return false;
+    }
+    const uint8_t* const end = begin + vector_capacity(vector) * vector_elements_size(vector);
+    const uint8_t* const first = self->data;
+    const uint8_t* const last = view_element(self, self->size - 1) + self->elements_size;
+    return first < end && begin < last;
+}
+///////////
+// Basic //
+///////////
+/**
+ * @brief Create a view over every element of a vector container.
+ *
+ * @param vector Vector container to look at.
+ *
+ * @return A view of vector, empty if vector is NULL.
+ */
+vector_view_t vector_view(vector_t* const vector) {
+    if (!vector) {
+        return _EMPTY_VIEW_;
+    }
+    return vector_view_array(vector_cdata(vector), vector_elements_size(vector), vector_size(vector));
+}
+/**
+ * @brief Create a view over a contiguous array.
+ *
+ * @param array             First element of the array.
+ * @param elements_size     Size in bytes of each element.
+ * @param elements_count    How many elements the array holds.
+ *
+ * @return A view of array.
+ */
+vector_view_t vector_view_array(const void* const array, const size_t elements_size, const size_t elements_count) {
+    if (!array || !elements_size) {
+        return _EMPTY_VIEW_;
+    }
+    const vector_view_t view = { array, elements_count, elements_size, elements_size };
+    return view;
+}
+/**
+ * @brief Create a view over part of another view.
+ *
+ * @param self  View to slice.
+ * @param start Position of the first element in the slice.
+ * @param count How many elements the slice holds, clamped to the end of self.
+ *
+ * @return A view of count elements of self starting at start.
+ */
+vector_view_t vector_view_slice(const vector_view_t* const self, const size_t start, const size_t count) {
+    if (!self || start >= self->size) {
+        return _EMPTY_VIEW_;
+    }
+    const vector_view_t view = {
+        view_element(self, start),
+        count < self->size - start ? count : self->size - start,
+        self->elements_size,
+        self->stride
+    };
+    return view;
+}
+/**
+ * @brief Create a view over every step-th element of another view.
+ *
+ * @param self  View to take elements from.
+ * @param step  Distance between taken elements, 1 takes them all.
+ *
+ * @return A strided view of self starting at its first element.
+ */
+vector_view_t vector_view_step(const vector_view_t* const self, const size_t step) {
+    if (!self || !step || !self->size) {
+        return _EMPTY_VIEW_;
+    }
+    const vector_view_t view = { self->data, (self->size + step - 1) / step, self->elements_size, self->stride * step };
+    return view;
+}
+////////////
+// Access //
+////////////
+/**
+ * @brief Returns a element from a view at given position.
+ *
+ * @param self  View to get element from.
+ * @param index Position of the element. Start point is 0.
+ *
+ * @return Return the element at index, or NULL if index is out of the view.
+ */
+const void* vector_view_at(const vector_view_t* const self, const size_t index) {
+    if (!self || index >= self->size) {
+        return NULL;
+    }
+    return view_element(self, index);
+}
+/**
+ * @brief Return the last element in a view.
+ *
+ * @param self View to get last element from.
+ *
+ * @return Return the last element in self, or NULL if it is empty.
+ */
+const void* vector_view_back(const vector_view_t* const self) {
+    return self && self->size ? view_element(self, self->size - 1) : NULL;
+}
+/**
+ * @brief Return the first element in a view.
+ *
+ * @param self View to get first element from.
+ *
+ * @return Return the first element in self, or NULL if it is empty.
+ */
+const void* vector_view_front(const vector_view_t* const self) {
+    return self && self->size ? self->data : NULL;
+}
+/**
+ * @brief Returns if the elements of a view are adjacent in memory.
+ *
+ * @param self View to check.
+ *
+ * @return Return true if self stride equals its elements size.
+ */
+bool vector_view_is_contiguous(const vector_view_t* const self) {
+    return self && self->stride == self->elements_size;
+}
+/**
+ * @brief Returns if a view has any elements at all.
+ *
+ * @param self View to check size from.
+ *
+ * @return Return true if self has 0 size.
+ */
+bool vector_view_is_empty(const vector_view_t* const self) {
+    return self ? self->size == 0 : true;
+}
+/**
+ * @brief Returns how many elements a view holds.
+ *
+ * @param self View to retrieve size from.
+ *
+ * @return Return the size of self.
+ */
+size_t vector_view_size(const vector_view_t* const self) {
+    return self ? self->size : 0;
+}
+/**
+ * @brief Copy the elements of a view into an array.
+ *
+ * @param self          View whose elements will be copied.
+ * @param array         Array that will receive the elements back to back.
+ * @param array_size    How many elements array can hold.
+ */
+void vector_view_to_array(const vector_view_t* const self, void* const array, const size_t array_size) {
+    if (!self || !array) {
+        return;
+    }
+    const size_t count = array_size < self->size ? array_size : self->size;
+    if (vector_view_is_contiguous(self)) {
+        memcpy(array, self->data, count * self->elements_size);
+        return;
+    }
+    for (size_t i = 0; i < count; ++i) {
+        memcpy((uint8_t*)array + i * self->elements_size, view_element(self, i), self->elements_size);
+    }
+}
+////////////////
+// Algorithms //
+////////////////
+/**
+ * @brief Call a function on every element of a view, in order.
+ *
+ * @param self      View whose elements will be visited.
+ * @param function  Function called once per element.
+ * @param context   Pointer handed unchanged to every function call.
+ */
+void vector_view_for_each(const vector_view_t* const self, void (*function)(const void* const element, void* const context), void* const context) {
+    if (!self || !function) {
+        return;
+    }
+    for (size_t i = 0; i < self->size; ++i) {
+        function(view_element(self, i), context);
+    }
+}
+/**
+ * @brief Find the first element of a view equal to key.
+ *
+ * @param self      View to search.
+ * @param key       Element to look for.
+ * @param compare   qsort style comparison function.
+ *
+ * @return Return the index of the first match, or the view size if there is none.
+ */
+size_t vector_view_find(const vector_view_t* const self, const void* const key, vector_compare compare) {
+    if (!self || !key || !compare) {
+        return vector_view_size(self);
+    }
+    for (size_t i = 0; i < self->size; ++i) {
+        if (!compare(view_element(self, i), key)) {
+            return i;
+        }
+    }
+    return self->size;
+}
+/**
+ * @brief Returns if a view is sorted.
+ *
+ * @param self      View to check.
+ * @param compare   qsort style comparison function.
+ *
+ * @return Return true if no element compares lower than the one before it.
+ */
+bool vector_view_is_sorted(const vector_view_t* const self, vector_compare compare) {
+    if (!self || !compare) {
+        return false;
+    }
+    for (size_t i = 1; i < self->size; ++i) {
+        if (compare(view_element(self, i), view_element(self, i - 1)) < 0) {
+            return false;
+        }
+    }
+    return true;
+}
+/**
+ * @brief Find the first position in a sorted view not lower than key.
+ *
+ * @param self      Sorted view to search.
+ * @param key       Element to look for.
+ * @param compare   qsort style comparison function.
+ *
+ * @return Return the index of the first element not lower than key, or the view size.
+ */
+size_t vector_view_lower_bound(const vector_view_t* const self, const void* const key, vector_compare compare) {
+    if (!self || !key || !compare) {
+        return 0;
+    }
+    size_t first = 0;
+    size_t count = self->size;
+    while (count) {
+        const size_t half = count / 2;
+        if (compare(view_element(self, first + half), key) < 0) {
+            first += half + 1;
+            count -= half + 1;
+        }
+        else {
+            count = half;
+        }
+    }
+    return first;
+}
+/**
+ * @brief Find the first position in a sorted view greater than key.
+ *
+ * @param self      Sorted view to search.
+ * @param key       Element to look for.
+ * @param compare   qsort style comparison function.
+ *
+ * @return Return the index of the first element greater than key, or the view size.
+ */
+size_t vector_view_upper_bound(const vector_view_t* const self, const void* const key, vector_compare compare) {
+    if (!self || !key || !compare) {
+        return 0;
+    }
+    size_t first = 0;
+    size_t count = self->size;
+    while (count) {
+        const size_t half = count / 2;
+        if (compare(key, view_element(self, first + half)) >= 0) {
+            first += half + 1;
+            count -= half + 1;
+        }
+        else {
+            count = half;
+        }
+    }
+    return first;
+}
+/**
+ * @brief Find an element equal to key in a sorted view.
+ *
+ * @param self      Sorted view to search.
+ * @param key       Element to look for.
+ * @param compare   qsort style comparison function.
+ *
+ * @return Return a pointer to a matching element, or NULL if there is none.
+ */
+const void* vector_view_binary_search(const vector_view_t* const self, const void* const key, vector_compare compare) {
+    if (!self || !key || !compare) {
+        return NULL;
+    }
+    const size_t index = vector_view_lower_bound(self, key, compare);
+    if (index >= self->size) {
+        return NULL;
+    }
+    const void* const element = view_element(self, index);
+    return compare(element, key) ? NULL : element;
+}
+/**
+ * @brief Copy the elements of a view into a vector container.
+ *
+ * @param dst   Vector container that will receive the elements, NULL creates one. May be the vector self looks into.
+ * @param self  View whose elements will be copied.
+ *
+ * @return Return dst holding a copy of every element in self.
+ */
+vector_t* vector_view_copy(vector_t* dst, const vector_view_t* const self) {
+    if (!self || !self->elements_size || (dst && vector_elements_size(dst) != self->elements_size)) {
+        return NULL;
+    }
+    if (!dst) {
+        dst = vector_init(self->elements_size, self->size);
+        if (!dst) {
+            return NULL;
+        }
+    }
+    else if (view_overlaps(self, dst)) {
+        // Clearing dst would pull the elements out from under the view, copy them aside first.
+        vector_t* const copy = vector_view_copy(NULL, self);
+        if (!copy) {
+            return NULL;
+        }
+        vector_clear(dst);
+        vector_append_n(dst, vector_cdata(copy), self->elements_size, self->size);
+        vector_destroy(copy);
+        return dst;
+    }
+    else {
+        vector_clear(dst);
+    }
+    if (vector_view_is_contiguous(self)) {
+        vector_append_n(dst, self->data, self->elements_size, self->size);
+        return dst;
+    }
+    vector_reserve(dst, self->size);
+    for (size_t i = 0; i < self->size; ++i) {
+        vector_push_back(dst, view_element(self, i), self->elements_size);
+    }
+    return dst;
+}
@@ -0,0 +1,74 @@
+/*
+MIT License
+
+Copyright (c) 2018 Joseph Ojeda
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef VECTOR_VIEW_H
+#define VECTOR_VIEW_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "./vector.h"
+#include "./vector_sort.h"
+
+/*
+ * Non-owning window over elements stored elsewhere: a vector_t, a subrange
+ * of one, or any array. Views are plain values, creating and slicing them
+ * never allocates. Element i lives at data + i * stride. A view is only
+ * valid while the storage it points into is neither freed nor reallocated.
+ */
+typedef struct vector_view {
+    const void* data;
+    size_t size;
+    size_t elements_size;
+    size_t stride;
+} vector_view_t;
+///////////
+// Basic //
+///////////
+vector_view_t   vector_view(vector_t* const vector);
+vector_view_t   vector_view_array(const void* const array, const size_t elements_size, const size_t elements_count);
+vector_view_t   vector_view_slice(const vector_view_t* const self, const size_t start, const size_t count);
+vector_view_t   vector_view_step(const vector_view_t* const self, const size_t step);
+////////////
+// Access //
+////////////
+const void*     vector_view_at(const vector_view_t* const self, const size_t index);
+const void*     vector_view_back(const vector_view_t* const self);
+const void*     vector_view_front(const vector_view_t* const self);
+bool            vector_view_is_contiguous(const vector_view_t* const self);
+bool            vector_view_is_empty(const vector_view_t* const self);
+size_t          vector_view_size(const vector_view_t* const self);
+void            vector_view_to_array(const vector_view_t* const self, void* const array, const size_t array_size);
+////////////////
+// Algorithms //
+////////////////
+void            vector_view_for_each(const vector_view_t* const self, void (*function)(const void* const element, void* const context), void* const context);
+size_t          vector_view_find(const vector_view_t* const self, const void* const key, vector_compare compare);
+bool            vector_view_is_sorted(const vector_view_t* const self, vector_compare compare);
+size_t          vector_view_lower_bound(const vector_view_t* const self, const void* const key, vector_compare compare);
+size_t          vector_view_upper_bound(const vector_view_t* const self, const void* const key, vector_compare compare);
+const void*     vector_view_binary_search(const vector_view_t* const self, const void* const key, vector_compare compare);
+vector_t*       vector_view_copy(vector_t* dst, const vector_view_t* const self);
+
+#endif
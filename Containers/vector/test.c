@@ -22,10 +22,56 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.
 */
 
+#include <pthread.h>
 #include <stdio.h>
 #include <stdlib.h>
 
 #include "./src/vector.h"
+#include "./src/vector_concurrent.h"
+#include "./src/vector_parallel.h"
+#include "./src/vector_sort.h"
+#include "./src/vector_typed.h"
+#include "./src/vector_view.h"
+
+VECTOR_DEFINE(int32, int32_t)
+
+static int compare_int(const void* const a, const void* const b) {
+    return (*(const int*)a > *(const int*)b) - (*(const int*)a < *(const int*)b);
+}
+
+static void sum_int(void* const accumulator, const void* const element, void* const context) {
+    (void)context;
+    *(long*)accumulator += *(const int*)element;
+}
+
+static void sum_long(void* const accumulator, const void* const other, void* const context) {
+    (void)context;
+    *(long*)accumulator += *(const long*)other;
+}
+
+static void add_int(const void* const element, void* const context) {
+    *(long*)context += *(const int*)element;
+}
+
+#define PRODUCERS 4
+#define PRODUCED 10000
+
+static void* produce(void* const argument) {
+    vector_concurrent_t* const self = argument;
+    int batch[8] = { 1, 1, 1, 1, 1, 1, 1, 1 };
+    for (int i = 0; i < PRODUCED; i += 10) {
+        const int one = 1;
+        vector_concurrent_push_back(self, &one, sizeof(int));
+        vector_concurrent_push_back(self, &one, sizeof(int));
+        vector_concurrent_append_n(self, batch, sizeof(int), 8);
+    }
+    return NULL;
+}
+
+static bool is_odd(const void* const element, void* const context) {
+    (void)context;
+    return *(const int*)element % 2;
+}
 
 int main(void) {
     vector_t* vector1 = vector_init(sizeof(int), 0);
@@ -88,8 +134,177 @@ int main(void) {
         printf("vector2.data = %d\n", *(int*)(vector_at(vector2, i)));
     }
 
+    int block[] = { 1, 2, 3, 4 };
+    vector_append_n(vector2, block, sizeof(int), 4);
+    vector_insert_n(vector2, block, sizeof(int), 2, 1);
+    printf("\nvector2.size = %ld\n", vector_size(vector2));
+    printf("vector2.capacity = %ld\n", vector_capacity(vector2));
+    for (size_t i = 0; i < vector_size(vector2); ++i) {
+        printf("vector2.data = %d\n", *(int*)(vector_at(vector2, i)));
+    }
+
+    vector_t* vector3 = vector_copy(NULL, vector2);
+    printf("\nvector3.size = %ld\n", vector_size(vector3));
+    printf("vector3.back = %d\n", *(int*)(vector_back(vector3)));
+
+    vector_erase(vector3, 0, 2);
+    printf("\nvector3.size = %ld\n", vector_size(vector3));
+    printf("vector3.front = %d\n", *(int*)(vector_front(vector3)));
+    printf("vector_erase_if(vector3, is_odd) = %ld\n", vector_erase_if(vector3, is_odd, NULL));
+    for (size_t i = 0; i < vector_size(vector3); ++i) {
+        printf("vector3.data = %d\n", *(int*)(vector_at(vector3, i)));
+    }
+
+    vector_t* vector4 = vector_init_flags(sizeof(int), 1 << 20, VECTOR_ZERO_PAGES);
+    vector_resize(vector4, 1 << 19, NULL);
+    printf("\nvector4.size = %ld\n", vector_size(vector4));
+    printf("vector4.capacity = %ld\n", vector_capacity(vector4));
+    printf("vector4.back = %d\n", *(int*)(vector_back(vector4)));
+
+    vector_t* vector5 = vector_init_flags(sizeof(int), 0, VECTOR_MMAP);
+    for (int i = 0; i < 100000; ++i) {
+        vector_push_back(vector5, &i, sizeof(int));
+    }
+    vector_erase(vector5, 10, 99999);
+    vector_shrink_to_fit(vector5);
+    printf("\nvector5.size = %ld\n", vector_size(vector5));
+    printf("vector5.capacity = %ld\n", vector_capacity(vector5));
+    printf("vector5.back = %d\n", *(int*)(vector_back(vector5)));
+
+    vector_pool_t* pool = vector_pool_init(0);
+    vector_t* vector6 = vector_init(sizeof(int), 0);
+    for (int i = 100000; i > 0; --i) {
+        vector_push_back(vector6, &i, sizeof(int));
+    }
+    long sum = 0;
+    vector_parallel_reduce(pool, vector6, &sum, sizeof(long), sum_int, sum_long, NULL);
+    vector_parallel_sort(pool, vector6, compare_int);
+    printf("\nvector_pool_size(pool) = %ld\n", vector_pool_size(pool));
+    printf("vector6.sum = %ld\n", sum);
+    printf("vector6.front = %d\n", *(int*)(vector_front(vector6)));
+    printf("vector6.back = %d\n", *(int*)(vector_back(vector6)));
+
+    int keys[] = { 42, -7, 13, 42, 0, -7, 99 };
+    vector_t* vector7 = vector_init(sizeof(int), 0);
+    vector_append_n(vector7, keys, sizeof(int), sizeof(keys) / sizeof(keys[0]));
+    vector_radix_sort(vector7, VECTOR_KEY_INT32, 0);
+    printf("\nvector_unique(vector7) = %ld\n", vector_unique(vector7, compare_int));
+    for (size_t i = 0; i < vector_size(vector7); ++i) {
+        printf("vector7.data = %d\n", *(int*)(vector_at(vector7, i)));
+    }
+    int key = 13;
+    printf("vector_lower_bound(vector7, 13) = %ld\n", vector_lower_bound(vector7, &key, compare_int));
+
+    vector_t* vector8 = vector_init_small(sizeof(int), 4, VECTOR_DEFAULT);
+    for (int i = 0; i < 6; ++i) {
+        vector_push_back(vector8, &i, sizeof(int));
+    }
+    printf("\nvector8.size = %ld\n", vector_size(vector8));
+    printf("vector8.capacity = %ld\n", vector_capacity(vector8));
+    vector_erase(vector8, 0, 2);
+    vector_shrink_to_fit(vector8);
+    printf("vector8.capacity = %ld\n", vector_capacity(vector8));
+    printf("vector8.front = %d\n", *(int*)(vector_front(vector8)));
+    vector_swap(vector8, vector7);
+    printf("vector8.size = %ld\n", vector_size(vector8));
+    printf("vector7.back = %d\n", *(int*)(vector_back(vector7)));
+
+    vector_t* vector9 = vector_open_file("vector9.bin", sizeof(int));
+    vector_append_n(vector9, keys, sizeof(int), sizeof(keys) / sizeof(keys[0]));
+    vector_destroy(vector9);
+    vector9 = vector_open_file("vector9.bin", sizeof(int));
+    printf("\nvector9.size = %ld\n", vector_size(vector9));
+    printf("vector9.back = %d\n", *(int*)(vector_back(vector9)));
+    vector_destroy(vector9);
+    remove("vector9.bin");
+
+    vec_int32_t vector10 = VECTOR_EMPTY;
+    for (int32_t i = 0; i < 10; ++i) {
+        vec_int32_push(&vector10, i * i);
+    }
+    vec_int32_erase(&vector10, 0, 4);
+    printf("\nvector10.size = %ld\n", vec_int32_size(&vector10));
+    printf("vector10.capacity = %ld\n", vec_int32_capacity(&vector10));
+    printf("vector10.back = %d\n", *vec_int32_back(&vector10));
+    vec_int32_destroy(&vector10);
+
+    vector_view_t view = vector_view(vector6);
+    vector_view_t slice = vector_view_slice(&view, 10, 20);
+    vector_view_t evens = vector_view_step(&slice, 2);
+    printf("\nslice.size = %ld\n", vector_view_size(&slice));
+    printf("evens.size = %ld\n", vector_view_size(&evens));
+    printf("evens.back = %d\n", *(const int*)(vector_view_back(&evens)));
+    printf("vector_view_lower_bound(slice, 13) = %ld\n", vector_view_lower_bound(&slice, &key, compare_int));
+
+    const vector_growth_t doubling = { VECTOR_GROWTH_POWER_OF_TWO, 0, 0, 0, true };
+    vector_t* vector11 = vector_init(sizeof(int), 0);
+    vector_set_growth(vector11, &doubling);
+    for (int i = 0; i < 1000; ++i) {
+        vector_push_back(vector11, &i, sizeof(int));
+    }
+    vector_stats_t stats = vector_stats(vector11);
+    printf("\nvector11.capacity = %ld\n", vector_capacity(vector11));
+    printf("vector11.reallocations = %ld\n", stats.reallocations);
+    printf("vector11.bytes_moved = %ld\n", stats.bytes_moved);
+    vector_destroy(vector11);
+
+    vector_concurrent_t* vector12 = vector_concurrent_init(sizeof(int), 0);
+    for (int i = 0; i < 1000; ++i) {
+        vector_concurrent_push_back(vector12, &i, sizeof(int));
+    }
+    long concurrent_total = 0;
+    vector_concurrent_for_each(vector12, add_int, &concurrent_total);
+    printf("\nvector12.size = %ld\n", vector_concurrent_size(vector12));
+    printf("vector12.at(999) = %d\n", *(int*)vector_concurrent_at(vector12, 999));
+    printf("vector12.sum = %ld\n", concurrent_total);
+    vector_concurrent_destroy(vector12);
+
+    vector_concurrent_t* appended = vector_concurrent_init(sizeof(int), 0);
+    pthread_t producers[PRODUCERS];
+    for (int i = 0; i < PRODUCERS; ++i) {
+        pthread_create(&producers[i], NULL, produce, appended);
+    }
+    for (int i = 0; i < PRODUCERS; ++i) {
+        pthread_join(producers[i], NULL);
+    }
+    concurrent_total = 0;
+    vector_concurrent_for_each(appended, add_int, &concurrent_total);
+    printf("\nappended.size = %ld (expected %d)\n", vector_concurrent_size(appended), PRODUCERS * PRODUCED);
+    printf("appended.sum = %ld\n", concurrent_total);
+    if (vector_concurrent_size(appended) != PRODUCERS * PRODUCED || concurrent_total != PRODUCERS * PRODUCED) {
+        puts("appended lost elements");
+        return EXIT_FAILURE;
+    }
+    vector_concurrent_destroy(appended);
+
+    vector_t* vector13 = vector_init(sizeof(int), 0);
+    int* slots = vector_grow_by(vector13, 8);
+    for (int i = 0; i < 8; ++i) {
+        slots[i] = i * 10;
+    }
+    *(int*)vector_emplace_back(vector13) = 80;
+    *(int*)vector_emplace_at(vector13, 0) = -10;
+    printf("\nvector13.size = %ld\n", vector_size(vector13));
+    printf("vector13.front = %d\n", *(int*)vector_front(vector13));
+    printf("vector13.back = %d\n", *(int*)vector_back(vector13));
+    vector_destroy(vector13);
+
+    vector_t* snapshot = vector_copy(NULL, vector6);
+    printf("\nsnapshot shares vector6 = %d\n", vector_cdata(snapshot) == vector_cdata(vector6));
+    *(int*)vector_at(snapshot, 0) = -1;
+    printf("snapshot.front = %d, vector6.front = %d\n", *(const int*)vector_get(snapshot, 0), *(const int*)vector_get(vector6, 0));
+    printf("snapshot shares vector6 = %d\n", vector_cdata(snapshot) == vector_cdata(vector6));
+    vector_destroy(snapshot);
+
     vector_destroy(vector1);
     vector_destroy(vector2);
+    vector_destroy(vector3);
+    vector_destroy(vector4);
+    vector_destroy(vector5);
+    vector_destroy(vector6);
+    vector_destroy(vector7);
+    vector_destroy(vector8);
+    vector_pool_destroy(pool);
 
     return EXIT_SUCCESS;
 }
\ No newline at end of file